@@ -0,0 +1,383 @@
+/**
+ * PacketAckManager and command-to-ack round-trip benchmarks
+ * 
+ * The round trip runs the real client path (PacketCodec -> NetworkTransport
+ * -> PacketFramer -> PacketAckManager) against an in-process loopback
+ * server that acks every Envelope it receives, so it measures the client
+ * stack and the kernel's loopback, not the firmware. Each case runs once
+ * per SocketProfile so the effect of Nagle/buffer tuning is visible.
+ */
+#include "bench.hpp"
+#include "core/network_transport.hpp"
+#include "core/packet_ack_manager.hpp"
+#include "core/packet_codec.hpp"
+#include "core/packet_framer.hpp"
+#include "core/reliable_channel.hpp"
+#include "core/socket_profile.hpp"
+#include "util/logging.hpp"
+#include "op_controls.pb.h"
+#include <boost/asio.hpp>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace Bench {
+
+namespace {
+
+constexpr uint32_t ACK_TIMEOUT_MS = 1000;
+
+void ackCase(Report& report, const Options& options, const std::string& name, size_t window) {
+    if (!options.enabled(name)) {
+        return;
+    }
+    
+    // Never run: the wheel timer is armed but no timeout fires during the loop
+    boost::asio::io_context io_context;
+    PacketAckManager manager(io_context);
+    
+    size_t operations = options.quick ? 200000 : 2000000;
+    size_t acked = 0;
+    auto callback = [&acked](bool success, uint32_t) {
+        acked += success ? 1 : 0;
+    };
+    
+    std::vector<uint32_t> in_flight(window);
+    for (size_t i = 0; i < window; ++i) {
+        in_flight[i] = manager.getNextPacketId();
+        manager.registerPacket(in_flight[i], callback, ACK_TIMEOUT_MS);
+    }
+    
+    // Steady state: ack the oldest, register a new one
+    auto start = Clock::now();
+    for (size_t i = 0; i < operations; ++i) {
+        uint32_t& slot = in_flight[i % window];
+        manager.handleAck(slot);
+        slot = manager.getNextPacketId();
+        manager.registerPacket(slot, callback, ACK_TIMEOUT_MS);
+    }
+    double elapsed = secondsSince(start);
+    
+    manager.cancelAll();
+    
+    report.add(name)
+        .add("register_ack_pairs_per_sec", operations / elapsed)
+        .add("ns_per_pair", elapsed * 1e9 / operations)
+        .add("outstanding", static_cast<double>(window))
+        .add("acked", static_cast<double>(acked));
+}
+
+/**
+ * Reliable sends whose ack slab slot is still held by a packet MAX_PENDING
+ * ids older. registerPacket rejects those, and every send must fail at
+ * once without deadlocking, retrying or reaching the wire.
+ */
+void reliableCollisionCase(Report& report, const Options& options, const std::string& name) {
+    if (!options.enabled(name)) {
+        return;
+    }
+    
+    // Never run: nothing times out, so every failure below is a slab rejection
+    boost::asio::io_context io_context;
+    PacketAckManager manager(io_context);
+    
+    size_t transmitted = 0;
+    ReliableChannel channel(manager, [&transmitted](const PacketCodec::EncodedPacket&) {
+        ++transmitted;
+    });
+    
+    // Park a packet in the slot the channel's ids map to
+    uint32_t blocker = manager.getNextPacketId();
+    manager.registerPacket(blocker, nullptr, ACK_TIMEOUT_MS);
+    
+    PacketCodec::EncodedPacket packet;
+    uint8_t payload[] = {0x08, 0x01};
+    PacketCodec::encodeInto(payload, sizeof(payload), packet);
+    
+    size_t operations = options.quick ? 10000 : 100000;
+    size_t failed = 0;
+    
+    auto start = Clock::now();
+    for (size_t i = 0; i < operations; ++i) {
+        channel.send(blocker + PacketAckManager::MAX_PENDING, packet, [&failed](bool success) {
+            failed += success ? 0 : 1;
+        }, ACK_TIMEOUT_MS);
+    }
+    double elapsed = secondsSince(start);
+    
+    manager.cancelAll();
+    
+    if (failed != operations || transmitted != 0) {
+        log_error("Slab collision benchmark: {} of {} sends failed, {} transmitted",
+                  failed, operations, transmitted);
+    }
+    
+    report.add(name)
+        .add("rejected_sends_per_sec", operations / elapsed)
+        .add("sends", static_cast<double>(operations))
+        .add("failed", static_cast<double>(failed))
+        .add("transmitted", static_cast<double>(transmitted));
+}
+
+/**
+ * Minimal firmware stand-in: acks every Envelope that carries a packet_id
+ */
+class LoopbackAckServer {
+public:
+    LoopbackAckServer()
+        : acceptor_(io_context_, boost::asio::ip::tcp::endpoint(boost::asio::ip::address_v4::loopback(), 0))
+        , socket_(io_context_)
+        , framer_([this](PacketView packet) { handlePacket(packet); }) {
+        thread_ = std::thread([this]() { serve(); });
+    }
+    
+    ~LoopbackAckServer() {
+        boost::asio::post(io_context_, [this]() {
+            boost::system::error_code ec;
+            acceptor_.close(ec);
+            socket_.close(ec);
+        });
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+    }
+    
+    uint16_t getPort() const { return acceptor_.local_endpoint().port(); }
+    
+private:
+    void serve() {
+        acceptor_.async_accept(socket_, [this](const boost::system::error_code& ec) {
+            if (!ec) {
+                socket_.set_option(boost::asio::ip::tcp::no_delay(true));
+                startRead();
+            }
+        });
+        io_context_.run();
+    }
+    
+    void startRead() {
+        socket_.async_read_some(boost::asio::buffer(read_buffer_),
+            [this](const boost::system::error_code& ec, size_t bytes_read) {
+                if (ec) {
+                    return;
+                }
+                framer_.feedData(read_buffer_.data(), bytes_read);
+                if (!replies_.empty()) {
+                    // All acks for this read go back in one write
+                    boost::system::error_code write_ec;
+                    boost::asio::write(socket_, boost::asio::buffer(replies_), write_ec);
+                    replies_.clear();
+                }
+                startRead();
+            });
+    }
+    
+    void handlePacket(PacketView packet) {
+        if (!request_.ParseFromArray(packet.data(), static_cast<int>(packet.size())) ||
+            request_.packet_id() == 0) {
+            return;
+        }
+        
+        reply_.Clear();
+        reply_.mutable_ack()->set_packet_id(request_.packet_id());
+        
+        uint8_t payload[PacketCodec::MAX_PAYLOAD_SIZE];
+        size_t length = reply_.ByteSizeLong();
+        reply_.SerializeWithCachedSizesToArray(payload);
+        
+        PacketCodec::EncodedPacket encoded;
+        PacketCodec::encodeInto(payload, length, encoded);
+        replies_.insert(replies_.end(), encoded.bytes.data(), encoded.bytes.data() + encoded.size);
+    }
+    
+    boost::asio::io_context io_context_;
+    boost::asio::ip::tcp::acceptor acceptor_;
+    boost::asio::ip::tcp::socket socket_;
+    std::array<uint8_t, 1024> read_buffer_;
+    PacketFramer framer_;
+    op_controls::Envelope request_;
+    op_controls::Envelope reply_;
+    std::vector<uint8_t> replies_;
+    std::thread thread_;
+};
+
+/**
+ * Client side of the round trip: NetworkTransport + PacketAckManager wired
+ * the way CommunicationBackend wires them
+ */
+class RoundTripClient {
+public:
+    RoundTripClient(uint16_t port, const SocketProfile& profile)
+        : transport_("127.0.0.1", port, profile)
+        , opened_(transport_.open())
+        , manager_(transport_.getIoContext())
+        , acked_(0)
+        , failed_(0) {
+        transport_.setPacketReceivedCallback([this](PacketView packet) {
+            if (ack_envelope_.ParseFromArray(packet.data(), static_cast<int>(packet.size())) &&
+                ack_envelope_.has_ack()) {
+                manager_.handleAck(ack_envelope_.ack().packet_id());
+            }
+        });
+    }
+    
+    ~RoundTripClient() {
+        manager_.cancelAll();
+        transport_.close();
+    }
+    
+    bool isOpen() const { return opened_; }
+    
+    void send() {
+        uint32_t packet_id = manager_.getNextPacketId();
+        bool registered = manager_.registerPacket(packet_id, [this](bool success, uint32_t) {
+            (success ? acked_ : failed_).fetch_add(1, std::memory_order_release);
+        }, ACK_TIMEOUT_MS);
+        if (!registered) {
+            failed_.fetch_add(1, std::memory_order_release);
+            return;
+        }
+        
+        // Called from the bench thread only
+        command_.Clear();
+        command_.set_packet_id(packet_id);
+        command_.mutable_request_state();
+        
+        uint8_t payload[PacketCodec::MAX_PAYLOAD_SIZE];
+        size_t length = command_.ByteSizeLong();
+        command_.SerializeWithCachedSizesToArray(payload);
+        
+        PacketCodec::EncodedPacket encoded;
+        PacketCodec::encodeInto(payload, length, encoded);
+        transport_.writeAsync(encoded);
+    }
+    
+    uint64_t getCompleted() const {
+        return acked_.load(std::memory_order_acquire) + failed_.load(std::memory_order_acquire);
+    }
+    uint64_t getFailed() const { return failed_.load(std::memory_order_acquire); }
+    
+    void waitForCompleted(uint64_t count) const {
+        // Yield rather than spin hard; the I/O thread needs the core on small machines
+        while (getCompleted() < count) {
+            std::this_thread::yield();
+        }
+    }
+    
+private:
+    NetworkTransport transport_;
+    bool opened_;
+    PacketAckManager manager_;
+    op_controls::Envelope command_;
+    op_controls::Envelope ack_envelope_;    // I/O thread only
+    std::atomic<uint64_t> acked_;
+    std::atomic<uint64_t> failed_;
+};
+
+void roundTripLatencyCase(Report& report, const Options& options, const std::string& name,
+                          RoundTripClient& client) {
+    if (!options.enabled(name)) {
+        return;
+    }
+    
+    size_t warmup = 200;
+    size_t samples = options.quick ? 2000 : 20000;
+    uint64_t completed = client.getCompleted();
+    uint64_t failed_before = client.getFailed();
+    
+    std::vector<double> latencies_us;
+    latencies_us.reserve(samples);
+    
+    for (size_t i = 0; i < warmup + samples; ++i) {
+        auto start = Clock::now();
+        client.send();
+        client.waitForCompleted(++completed);
+        if (i >= warmup) {
+            latencies_us.push_back(secondsSince(start) * 1e6);
+        }
+    }
+    
+    double total = 0.0;
+    for (double latency : latencies_us) {
+        total += latency;
+    }
+    std::sort(latencies_us.begin(), latencies_us.end());
+    
+    report.add(name)
+        .add("p50_us", percentile(latencies_us, 0.50))
+        .add("p90_us", percentile(latencies_us, 0.90))
+        .add("p99_us", percentile(latencies_us, 0.99))
+        .add("max_us", latencies_us.back())
+        .add("mean_us", total / latencies_us.size())
+        .add("samples", static_cast<double>(samples))
+        .add("timeouts", static_cast<double>(client.getFailed() - failed_before));
+}
+
+void roundTripThroughputCase(Report& report, const Options& options, const std::string& name,
+                             RoundTripClient& client) {
+    if (!options.enabled(name)) {
+        return;
+    }
+    
+    constexpr size_t WINDOW = 32;
+    size_t total = options.quick ? 20000 : 200000;
+    uint64_t base = client.getCompleted();
+    uint64_t failed_before = client.getFailed();
+    size_t sent = 0;
+    
+    auto start = Clock::now();
+    while (sent < total) {
+        while (sent < total && sent - (client.getCompleted() - base) < WINDOW) {
+            client.send();
+            ++sent;
+        }
+        std::this_thread::yield();
+    }
+    client.waitForCompleted(base + total);
+    double elapsed = secondsSince(start);
+    
+    report.add(name)
+        .add("acks_per_sec", total / elapsed)
+        .add("window", static_cast<double>(WINDOW))
+        .add("timeouts", static_cast<double>(client.getFailed() - failed_before));
+}
+
+} // namespace
+
+void runAckBenchmarks(Report& report, const Options& options) {
+    ackCase(report, options, "ack.register_ack", 1);
+    ackCase(report, options, "ack.register_ack_window_256", 256);
+    reliableCollisionCase(report, options, "ack.reliable_slab_collision");
+}
+
+void runRoundTripBenchmarks(Report& report, const Options& options) {
+    const std::pair<const char*, SocketProfile> profiles[] = {
+        {"os_default", SocketProfile::osDefault()},
+        {"low_latency", SocketProfile::lowLatency()},
+        {"busy_poll", SocketProfile::busyPoll()}
+    };
+    
+    for (const auto& [profile_name, profile] : profiles) {
+        std::string prefix = std::string("roundtrip.") + profile_name;
+        std::string sequential = prefix + ".sequential";
+        std::string pipelined = prefix + ".pipelined";
+        if (!options.enabled(sequential) && !options.enabled(pipelined)) {
+            continue;
+        }
+        
+        LoopbackAckServer server;
+        RoundTripClient client(server.getPort(), profile);
+        if (!client.isOpen()) {
+            log_error("Round-trip benchmark could not connect to loopback server on port {}", server.getPort());
+            return;
+        }
+        
+        roundTripLatencyCase(report, options, sequential, client);
+        roundTripThroughputCase(report, options, pipelined, client);
+    }
+}
+
+} // namespace Bench
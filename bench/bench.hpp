@@ -0,0 +1,72 @@
+#ifndef BENCH_HPP
+#define BENCH_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * Shared plumbing for op-gclient-bench
+ * 
+ * Each suite adds named results (a flat set of numeric metrics) to a
+ * BenchReport, which is written out as JSON so runs can be diffed and
+ * tracked between releases.
+ */
+namespace Bench {
+
+struct Options {
+    bool quick = false;             // Shorter runs, for CI smoke tests
+    std::string filter;             // Only run results whose name contains this
+    
+    bool enabled(const std::string& name) const {
+        return filter.empty() || name.find(filter) != std::string::npos;
+    }
+};
+
+struct Result {
+    std::string name;               // "<suite>.<case>", e.g. "framer.noisy_stream"
+    std::vector<std::pair<std::string, double>> metrics;
+    
+    Result& add(const std::string& metric, double value) {
+        metrics.emplace_back(metric, value);
+        return *this;
+    }
+};
+
+class Report {
+public:
+    Result& add(const std::string& name) {
+        results_.push_back(Result{name, {}});
+        return results_.back();
+    }
+    
+    const std::vector<Result>& getResults() const { return results_; }
+    
+    std::string toJson() const;
+    
+private:
+    std::vector<Result> results_;
+};
+
+using Clock = std::chrono::steady_clock;
+
+inline double secondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+/**
+ * Percentile of an already sorted sample set (nearest rank)
+ */
+double percentile(const std::vector<double>& sorted, double fraction);
+
+// Suites
+void runPacketBenchmarks(Report& report, const Options& options);
+void runAckBenchmarks(Report& report, const Options& options);
+void runStateBenchmarks(Report& report, const Options& options);
+void runRoundTripBenchmarks(Report& report, const Options& options);
+
+} // namespace Bench
+
+#endif // BENCH_HPP
@@ -0,0 +1,111 @@
+/**
+ * op-gclient-bench: headless throughput/latency benchmarks for core/
+ * 
+ * Usage: op-gclient-bench [--quick] [--filter substring] [--output file.json]
+ * 
+ * JSON goes to stdout (and --output), a readable summary to stderr.
+ */
+#include "bench.hpp"
+#include "util/logging.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+namespace Bench {
+
+double percentile(const std::vector<double>& sorted, double fraction) {
+    if (sorted.empty()) {
+        return 0.0;
+    }
+    size_t rank = static_cast<size_t>(std::ceil(fraction * sorted.size()));
+    return sorted[std::min(sorted.size() - 1, rank > 0 ? rank - 1 : 0)];
+}
+
+std::string Report::toJson() const {
+    std::ostringstream out;
+    out.precision(6);
+    
+    char timestamp[32];
+    std::time_t now = std::time(nullptr);
+    std::strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+    
+    out << "{\n";
+    out << "  \"schema\": 1,\n";
+    out << "  \"timestamp\": \"" << timestamp << "\",\n";
+#ifdef NDEBUG
+    out << "  \"build\": \"release\",\n";
+#else
+    out << "  \"build\": \"debug\",\n";
+#endif
+    out << "  \"hardware_threads\": " << std::thread::hardware_concurrency() << ",\n";
+    out << "  \"results\": [";
+    
+    for (size_t i = 0; i < results_.size(); ++i) {
+        const Result& result = results_[i];
+        out << (i == 0 ? "\n" : ",\n");
+        out << "    {\"name\": \"" << result.name << "\", \"metrics\": {";
+        for (size_t m = 0; m < result.metrics.size(); ++m) {
+            double value = std::isfinite(result.metrics[m].second) ? result.metrics[m].second : 0.0;
+            out << (m == 0 ? "" : ", ") << "\"" << result.metrics[m].first << "\": " << value;
+        }
+        out << "}}";
+    }
+    
+    out << "\n  ]\n}\n";
+    return out.str();
+}
+
+} // namespace Bench
+
+int main(int argc, char** argv) {
+    Bench::Options options;
+    std::string output_path;
+    
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--quick") {
+            options.quick = true;
+        } else if (arg == "--filter" && i + 1 < argc) {
+            options.filter = argv[++i];
+        } else if (arg == "--output" && i + 1 < argc) {
+            output_path = argv[++i];
+        } else {
+            std::fprintf(stderr, "Usage: %s [--quick] [--filter substring] [--output file.json]\n", argv[0]);
+            return arg == "--help" ? 0 : 1;
+        }
+    }
+    
+    // Benchmarks measure the code, not the console
+    spdlog::set_level(spdlog::level::err);
+    
+    Bench::Report report;
+    Bench::runPacketBenchmarks(report, options);
+    Bench::runAckBenchmarks(report, options);
+    Bench::runStateBenchmarks(report, options);
+    Bench::runRoundTripBenchmarks(report, options);
+    
+    for (const auto& result : report.getResults()) {
+        std::fprintf(stderr, "%s\n", result.name.c_str());
+        for (const auto& [metric, value] : result.metrics) {
+            std::fprintf(stderr, "    %-28s %14.2f\n", metric.c_str(), value);
+        }
+    }
+    
+    std::string json = report.toJson();
+    std::fputs(json.c_str(), stdout);
+    
+    if (!output_path.empty()) {
+        std::ofstream file(output_path);
+        file << json;
+        if (!file) {
+            std::fprintf(stderr, "Failed to write %s\n", output_path.c_str());
+            return 1;
+        }
+    }
+    
+    return 0;
+}
@@ -0,0 +1,79 @@
+/**
+ * GimbalState read/write contention benchmark
+ * 
+ * One writer (the I/O thread's role) publishes positions as fast as it can
+ * while N readers (the GUI's role) take snapshots. Both rates are reported
+ * so a regression on either side of the seqlock shows up.
+ */
+#include "bench.hpp"
+#include "core/gimbal_state.hpp"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace Bench {
+
+namespace {
+
+void contentionCase(Report& report, const Options& options, const std::string& name, size_t readers) {
+    if (!options.enabled(name)) {
+        return;
+    }
+    
+    GimbalState state;
+    std::atomic<bool> running{true};
+    std::atomic<uint64_t> reads{0};
+    std::atomic<uint64_t> torn{0};
+    uint64_t writes = 0;
+    
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < readers; ++i) {
+        threads.emplace_back([&]() {
+            uint64_t local_reads = 0;
+            uint64_t local_torn = 0;
+            while (running.load(std::memory_order_relaxed)) {
+                // Writer keeps pan and tilt equal, so a mismatch is a torn read
+                GimbalState::Snapshot snapshot = state.getSnapshot();
+                local_torn += snapshot.position.pan_deg != snapshot.position.tilt_deg ? 1 : 0;
+                ++local_reads;
+            }
+            reads.fetch_add(local_reads, std::memory_order_relaxed);
+            torn.fetch_add(local_torn, std::memory_order_relaxed);
+        });
+    }
+    
+    double duration_s = options.quick ? 0.2 : 1.0;
+    auto start = Clock::now();
+    double elapsed = 0.0;
+    while (elapsed < duration_s) {
+        for (int i = 0; i < 1024; ++i) {
+            GimbalState::Position position;
+            position.pan_deg = static_cast<float>(writes & 0xFFFF);
+            position.tilt_deg = position.pan_deg;
+            state.setPosition(position);
+            ++writes;
+        }
+        elapsed = secondsSince(start);
+    }
+    
+    running = false;
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    
+    report.add(name)
+        .add("writes_per_sec", writes / elapsed)
+        .add("reads_per_sec", reads.load() / elapsed)
+        .add("readers", static_cast<double>(readers))
+        .add("torn_reads", static_cast<double>(torn.load()));
+}
+
+} // namespace
+
+void runStateBenchmarks(Report& report, const Options& options) {
+    contentionCase(report, options, "state.uncontended", 0);
+    contentionCase(report, options, "state.one_reader", 1);
+    contentionCase(report, options, "state.three_readers", 3);
+}
+
+} // namespace Bench
@@ -0,0 +1,549 @@
+#include "gimbal_simulator.hpp"
+#include "core/packet_framer.hpp"
+#include "util/logging.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <deque>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+#ifdef __APPLE__
+#include <util.h>
+#else
+#include <pty.h>
+#endif
+
+using Clock = std::chrono::steady_clock;
+
+namespace {
+    constexpr uint32_t MAX_STREAM_RATE_HZ = 10000;
+    
+    // Outbound bytes buffered per link before packets are dropped, e.g. a PTY
+    // nobody has opened (a real UART just loses them)
+    constexpr size_t MAX_PENDING_BYTES = 16 * 1024;
+    
+    constexpr float SENSOR_NOISE_DEG = 0.02f;
+}
+
+// ═══════════════════════════════════════
+// Links: one per TCP client, one for the PTY
+// ═══════════════════════════════════════
+
+class GimbalSimulator::Link : public std::enable_shared_from_this<Link> {
+public:
+    Link(GimbalSimulator& simulator, std::string name)
+        : simulator_(simulator)
+        , name_(std::move(name))
+        , framer_([this](PacketView packet) {
+              simulator_.handlePacket(*this, packet);
+          })
+        , delay_timer_(simulator.io_context_) {
+    }
+    
+    virtual ~Link() = default;
+    
+    virtual void start() = 0;
+    virtual void close() = 0;
+    
+    const std::string& getName() const { return name_; }
+    
+    /**
+     * Send now, or after the configured latency (order is kept)
+     */
+    bool queue(const PacketCodec::EncodedPacket& packet) {
+        const SimulatorConfig& config = simulator_.config_;
+        if (config.latency_ms == 0 && config.jitter_ms == 0) {
+            return append(packet);
+        }
+        
+        uint32_t delay_ms = config.latency_ms;
+        if (config.jitter_ms > 0) {
+            delay_ms += std::uniform_int_distribution<uint32_t>(0, config.jitter_ms)(simulator_.rng_);
+        }
+        
+        // A byte stream cannot reorder, so never due before the previous packet
+        Clock::time_point due = std::max(last_due_, Clock::now() + std::chrono::milliseconds(delay_ms));
+        last_due_ = due;
+        
+        bool was_empty = delayed_.empty();
+        delayed_.push_back({due, packet});
+        if (was_empty) {
+            armDelayTimer();
+        }
+        return true;
+    }
+    
+protected:
+    struct Delayed {
+        Clock::time_point due;
+        PacketCodec::EncodedPacket packet;
+    };
+    
+    virtual void startWrite() = 0;
+    
+    void handleRead(const uint8_t* data, size_t length) {
+        framer_.feedData(data, length);
+    }
+    
+    bool append(const PacketCodec::EncodedPacket& packet) {
+        if (pending_.size() + packet.size > MAX_PENDING_BYTES) {
+            return false;
+        }
+        pending_.insert(pending_.end(), packet.bytes.data(), packet.bytes.data() + packet.size);
+        if (!write_in_flight_) {
+            startWrite();
+        }
+        return true;
+    }
+    
+    void armDelayTimer() {
+        delay_timer_.expires_at(delayed_.front().due);
+        delay_timer_.async_wait([self = shared_from_this()](const boost::system::error_code& ec) {
+            if (ec) {
+                return;
+            }
+            Clock::time_point now = Clock::now();
+            while (!self->delayed_.empty() && self->delayed_.front().due <= now) {
+                self->append(self->delayed_.front().packet);
+                self->delayed_.pop_front();
+            }
+            if (!self->delayed_.empty()) {
+                self->armDelayTimer();
+            }
+        });
+    }
+    
+    GimbalSimulator& simulator_;
+    std::string name_;
+    PacketFramer framer_;
+    
+    std::deque<Delayed> delayed_;
+    boost::asio::steady_timer delay_timer_;
+    Clock::time_point last_due_;
+    
+    // Double-buffered: append to pending_ while writing_ is on the wire
+    std::vector<uint8_t> pending_;
+    std::vector<uint8_t> writing_;
+    bool write_in_flight_ = false;
+};
+
+template <typename Stream>
+class GimbalSimulator::StreamLink : public GimbalSimulator::Link {
+public:
+    StreamLink(GimbalSimulator& simulator, std::string name, Stream stream)
+        : Link(simulator, std::move(name))
+        , stream_(std::move(stream)) {
+    }
+    
+    void start() override {
+        startRead();
+    }
+    
+    void close() override {
+        boost::system::error_code ec;
+        delay_timer_.cancel();
+        stream_.close(ec);
+    }
+    
+private:
+    void startRead() {
+        stream_.async_read_some(
+            boost::asio::buffer(read_buffer_),
+            [this, self = shared_from_this()](const boost::system::error_code& ec, size_t bytes_read) {
+                if (ec) {
+                    if (ec != boost::asio::error::operation_aborted) {
+                        log_info("Link {} closed: {}", name_, ec.message());
+                        simulator_.removeLink(this);
+                    }
+                    return;
+                }
+                handleRead(read_buffer_.data(), bytes_read);
+                startRead();
+            });
+    }
+    
+    void startWrite() override {
+        if (pending_.empty()) {
+            return;
+        }
+        writing_.swap(pending_);
+        pending_.clear();
+        write_in_flight_ = true;
+        
+        boost::asio::async_write(
+            stream_,
+            boost::asio::buffer(writing_),
+            [this, self = shared_from_this()](const boost::system::error_code& ec, size_t) {
+                write_in_flight_ = false;
+                if (ec) {
+                    return;  // The read side notices and removes the link
+                }
+                startWrite();
+            });
+    }
+    
+    Stream stream_;
+    std::array<uint8_t, 1024> read_buffer_;
+};
+
+// ═══════════════════════════════════════
+// Simulator
+// ═══════════════════════════════════════
+
+GimbalSimulator::GimbalSimulator(const SimulatorConfig& config)
+    : config_(config)
+    , acceptor_(io_context_)
+    , stream_timer_(io_context_)
+    , stats_timer_(io_context_)
+    , signals_(io_context_, SIGINT, SIGTERM)
+    , pty_slave_fd_(-1)
+    , rng_(config.seed != 0 ? config.seed : std::random_device{}())
+    , position_deg_(0.0f)
+    , setpoint_deg_(0.0f)
+    , mode_(op_controls::GIMBAL_MODE_FREE)
+    , streaming_(config.stream_on_connect)
+    , stream_rate_hz_(std::clamp<uint32_t>(config.stream_rate_hz, 1, MAX_STREAM_RATE_HZ)) {
+}
+
+GimbalSimulator::~GimbalSimulator() {
+    for (auto& link : links_) {
+        link->close();
+    }
+    links_.clear();
+    
+    if (pty_slave_fd_ >= 0) {
+        ::close(pty_slave_fd_);
+    }
+    if (!config_.pty_link.empty()) {
+        ::unlink(config_.pty_link.c_str());
+    }
+}
+
+bool GimbalSimulator::start() {
+    if (config_.tcp_port == 0 && !config_.enable_pty) {
+        log_error("Nothing to serve: enable TCP and/or the PTY");
+        return false;
+    }
+    
+    if (config_.tcp_port != 0) {
+        try {
+            boost::asio::ip::tcp::endpoint endpoint(boost::asio::ip::tcp::v4(), config_.tcp_port);
+            acceptor_.open(endpoint.protocol());
+            acceptor_.set_option(boost::asio::ip::tcp::acceptor::reuse_address(true));
+            acceptor_.bind(endpoint);
+            acceptor_.listen();
+            log_info("Listening on TCP port {}", config_.tcp_port);
+            startAccept();
+        } catch (const boost::system::system_error& e) {
+            log_error("Failed to listen on TCP port {}: {}", config_.tcp_port, e.what());
+            return false;
+        }
+    }
+    
+    if (config_.enable_pty && !openPty()) {
+        return false;
+    }
+    
+    signals_.async_wait([this](const boost::system::error_code& ec, int) {
+        if (!ec) {
+            log_info("Stopping simulator");
+            stop();
+        }
+    });
+    
+    last_update_ = Clock::now();
+    scheduleStream();
+    scheduleStats();
+    
+    log_info("Streaming {} at {} Hz; loss {:.1f}%, corruption {:.1f}%, latency {}+{} ms",
+             streaming_ ? "on" : "off", stream_rate_hz_,
+             config_.loss * 100.0, config_.corruption * 100.0,
+             config_.latency_ms, config_.jitter_ms);
+    return true;
+}
+
+void GimbalSimulator::run() {
+    io_context_.run();
+}
+
+void GimbalSimulator::stop() {
+    io_context_.stop();
+}
+
+void GimbalSimulator::startAccept() {
+    acceptor_.async_accept([this](const boost::system::error_code& ec, boost::asio::ip::tcp::socket socket) {
+        if (!ec) {
+            boost::system::error_code option_ec;
+            socket.set_option(boost::asio::ip::tcp::no_delay(true), option_ec);
+            
+            auto remote = socket.remote_endpoint(option_ec);
+            std::string name = "tcp " + remote.address().to_string() + ":" + std::to_string(remote.port());
+            addLink(std::make_shared<StreamLink<boost::asio::ip::tcp::socket>>(*this, name, std::move(socket)));
+        } else if (ec == boost::asio::error::operation_aborted) {
+            return;
+        } else {
+            log_warn("Accept failed: {}", ec.message());
+        }
+        startAccept();
+    });
+}
+
+bool GimbalSimulator::openPty() {
+    int master_fd = -1;
+    int slave_fd = -1;
+    char name[256] = {};
+    
+    if (::openpty(&master_fd, &slave_fd, name, nullptr, nullptr) != 0) {
+        log_error("openpty failed: {}", std::strerror(errno));
+        return false;
+    }
+    
+    // Raw bytes both ways, as on a real UART
+    termios settings;
+    if (::tcgetattr(slave_fd, &settings) == 0) {
+        ::cfmakeraw(&settings);
+        ::tcsetattr(slave_fd, TCSANOW, &settings);
+    }
+    
+    // Keep our own slave handle open so the master does not see EIO/hang-up
+    // every time the client closes the port
+    pty_slave_fd_ = slave_fd;
+    pty_path_ = name;
+    
+    if (!config_.pty_link.empty()) {
+        ::unlink(config_.pty_link.c_str());
+        if (::symlink(name, config_.pty_link.c_str()) != 0) {
+            log_warn("Could not link {} -> {}: {}", config_.pty_link, name, std::strerror(errno));
+        }
+    }
+    
+    log_info("Serial PTY at {}{}", pty_path_,
+             config_.pty_link.empty() ? "" : " (linked from " + config_.pty_link + ")");
+    
+    boost::asio::posix::stream_descriptor master(io_context_, master_fd);
+    addLink(std::make_shared<StreamLink<boost::asio::posix::stream_descriptor>>(
+        *this, "pty " + pty_path_, std::move(master)));
+    return true;
+}
+
+void GimbalSimulator::addLink(std::shared_ptr<Link> link) {
+    log_info("Client connected: {}", link->getName());
+    links_.push_back(link);
+    link->start();
+    
+    // What the firmware reports on power-up
+    sendState(*link);
+}
+
+void GimbalSimulator::removeLink(Link* link) {
+    auto it = std::find_if(links_.begin(), links_.end(), [link](const std::shared_ptr<Link>& candidate) {
+        return candidate.get() == link;
+    });
+    if (it != links_.end()) {
+        (*it)->close();
+        links_.erase(it);
+    }
+}
+
+bool GimbalSimulator::chance(double probability) {
+    return probability > 0.0 && std::uniform_real_distribution<double>(0.0, 1.0)(rng_) < probability;
+}
+
+void GimbalSimulator::handlePacket(Link& link, PacketView packet) {
+    ++stats_.packets_received;
+    
+    if (chance(config_.loss)) {
+        ++stats_.dropped_rx;
+        return;
+    }
+    
+    if (!rx_envelope_.ParseFromArray(packet.data(), static_cast<int>(packet.size()))) {
+        ++stats_.parse_errors;
+        return;
+    }
+    
+    if (rx_envelope_.packet_id() != 0) {
+        tx_envelope_.Clear();
+        tx_envelope_.mutable_ack()->set_packet_id(rx_envelope_.packet_id());
+        send(link, tx_envelope_);
+        ++stats_.acks_sent;
+    }
+    
+    switch (rx_envelope_.msg_case()) {
+        case op_controls::Envelope::kSetMode: {
+            auto mode = rx_envelope_.set_mode().mode();
+            if (mode == op_controls::GIMBAL_MODE_ARMED && mode_ == op_controls::GIMBAL_MODE_FREE) {
+                setpoint_deg_ = position_deg_;  // Arm in place
+                mode_ = op_controls::GIMBAL_MODE_ARMED;
+            } else if (mode == op_controls::GIMBAL_MODE_FREE) {
+                mode_ = op_controls::GIMBAL_MODE_FREE;
+            }
+            log_info("Mode -> {}", op_controls::GimbalMode_Name(mode_));
+            break;
+        }
+        
+        case op_controls::Envelope::kPositionDemand:
+            setpoint_deg_ = std::clamp(rx_envelope_.position_demand().pan_deg(),
+                                       config_.pan_lower_deg, config_.pan_upper_deg);
+            break;
+        
+        case op_controls::Envelope::kStreamControl: {
+            const auto& control = rx_envelope_.stream_control();
+            if (control.rate_hz() != 0) {
+                stream_rate_hz_ = std::clamp<uint32_t>(control.rate_hz(), 1, MAX_STREAM_RATE_HZ);
+            }
+            bool was_streaming = streaming_;
+            streaming_ = control.enabled();
+            log_info("Streaming {} at {} Hz", streaming_ ? "on" : "off", stream_rate_hz_);
+            if (streaming_ && (!was_streaming || control.rate_hz() != 0)) {
+                stream_timer_.cancel();
+                scheduleStream();
+            }
+            break;
+        }
+        
+        case op_controls::Envelope::kRequestState:
+            sendState(link);
+            break;
+        
+        default:
+            // Device-to-client messages, or nothing set
+            break;
+    }
+}
+
+void GimbalSimulator::send(Link& link, const op_controls::Envelope& envelope) {
+    std::array<uint8_t, PacketCodec::MAX_PAYLOAD_SIZE> payload;
+    size_t size = envelope.ByteSizeLong();
+    if (size > payload.size()) {
+        log_warn("Envelope too large to frame: {} bytes", size);
+        return;
+    }
+    envelope.SerializeWithCachedSizesToArray(payload.data());
+    
+    PacketCodec::EncodedPacket packet;
+    PacketCodec::encodeInto(payload.data(), size, packet);
+    
+    if (chance(config_.loss)) {
+        ++stats_.dropped_tx;
+        return;
+    }
+    if (chance(config_.corruption)) {
+        size_t index = std::uniform_int_distribution<size_t>(0, packet.size - 1)(rng_);
+        packet.bytes[index] ^= static_cast<uint8_t>(1u << std::uniform_int_distribution<int>(0, 7)(rng_));
+        ++stats_.corrupted_tx;
+    }
+    
+    if (link.queue(packet)) {
+        ++stats_.packets_sent;
+    } else {
+        ++stats_.dropped_tx;
+    }
+}
+
+void GimbalSimulator::sendState(Link& link) {
+    advanceModel();
+    
+    tx_envelope_.Clear();
+    auto* limits = tx_envelope_.mutable_limits();
+    limits->set_pan_lower_deg(config_.pan_lower_deg);
+    limits->set_pan_upper_deg(config_.pan_upper_deg);
+    send(link, tx_envelope_);
+    
+    tx_envelope_.Clear();
+    auto* health = tx_envelope_.mutable_health();
+    health->set_status(op_controls::HEALTH_STATUS_HEALTHY);
+    health->set_message("simulator");
+    send(link, tx_envelope_);
+    
+    tx_envelope_.Clear();
+    auto* telemetry = tx_envelope_.mutable_telemetry();
+    telemetry->set_pan_position_deg(position_deg_);
+    telemetry->set_pan_setpoint_deg(setpoint_deg_);
+    telemetry->set_mode(mode_);
+    send(link, tx_envelope_);
+}
+
+void GimbalSimulator::scheduleStream() {
+    if (!streaming_) {
+        return;
+    }
+    
+    // Absolute schedule so the rate does not drift with handler latency
+    Clock::time_point now = Clock::now();
+    if (next_tick_ < now - std::chrono::milliseconds(100)) {
+        next_tick_ = now;  // Fell far behind (or first tick): resync
+    }
+    next_tick_ += std::chrono::nanoseconds(1000000000ull / stream_rate_hz_);
+    
+    stream_timer_.expires_at(next_tick_);
+    stream_timer_.async_wait([this](const boost::system::error_code& ec) {
+        if (!ec) {
+            streamTick();
+        }
+    });
+}
+
+void GimbalSimulator::streamTick() {
+    advanceModel();
+    
+    float noise = std::normal_distribution<float>(0.0f, SENSOR_NOISE_DEG)(rng_);
+    
+    tx_envelope_.Clear();
+    auto* telemetry = tx_envelope_.mutable_telemetry();
+    telemetry->set_pan_position_deg(position_deg_ + noise);
+    telemetry->set_pan_setpoint_deg(setpoint_deg_);
+    telemetry->set_mode(mode_);
+    
+    for (auto& link : links_) {
+        send(*link, tx_envelope_);
+    }
+    
+    scheduleStream();
+}
+
+void GimbalSimulator::advanceModel() {
+    Clock::time_point now = Clock::now();
+    updateModel(std::chrono::duration<double>(now - last_update_).count());
+    last_update_ = now;
+}
+
+void GimbalSimulator::updateModel(double dt) {
+    if (mode_ == op_controls::GIMBAL_MODE_FREE) {
+        return;  // Motor off: the gimbal stays where it was left
+    }
+    
+    // Slew-limited move towards the setpoint
+    float step = static_cast<float>(config_.slew_deg_per_s * dt);
+    float error = setpoint_deg_ - position_deg_;
+    position_deg_ += std::clamp(error, -step, step);
+    
+    if (position_deg_ <= config_.pan_lower_deg) {
+        position_deg_ = config_.pan_lower_deg;
+        mode_ = op_controls::GIMBAL_MODE_LOWER_LIMIT;
+    } else if (position_deg_ >= config_.pan_upper_deg) {
+        position_deg_ = config_.pan_upper_deg;
+        mode_ = op_controls::GIMBAL_MODE_UPPER_LIMIT;
+    } else {
+        mode_ = op_controls::GIMBAL_MODE_ARMED;
+    }
+}
+
+void GimbalSimulator::scheduleStats() {
+    stats_timer_.expires_after(std::chrono::seconds(1));
+    stats_timer_.async_wait([this, last = stats_](const boost::system::error_code& ec) {
+        if (ec) {
+            return;
+        }
+        log_info("links {} | rx {}/s, tx {}/s, acks {}/s | dropped rx {} tx {}, corrupted {}, parse errors {}",
+                 links_.size(),
+                 stats_.packets_received - last.packets_received,
+                 stats_.packets_sent - last.packets_sent,
+                 stats_.acks_sent - last.acks_sent,
+                 stats_.dropped_rx, stats_.dropped_tx, stats_.corrupted_tx, stats_.parse_errors);
+        scheduleStats();
+    });
+}
@@ -0,0 +1,133 @@
+#ifndef GIMBAL_SIMULATOR_HPP
+#define GIMBAL_SIMULATOR_HPP
+
+#include <boost/asio.hpp>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "core/packet_codec.hpp"
+#include "core/packet_view.hpp"
+#include "op_controls.pb.h"
+
+/**
+ * Simulator settings (see --help in sim/main.cpp)
+ */
+struct SimulatorConfig {
+    uint16_t tcp_port = 3883;       // 0 disables TCP
+    bool enable_pty = false;
+    std::string pty_link;           // Optional symlink to the PTY slave, e.g. /tmp/ttyGIMBAL
+    
+    uint32_t stream_rate_hz = 50;   // Telemetry rate while streaming
+    bool stream_on_connect = true;
+    
+    // Impairments
+    double loss = 0.0;              // Probability a packet (either direction) is dropped
+    double corruption = 0.0;        // Probability a sent packet has one bit flipped
+    uint32_t latency_ms = 0;        // Added to everything the simulator sends
+    uint32_t jitter_ms = 0;         // Uniform extra delay, order is preserved
+    uint32_t seed = 0;              // 0 = random
+    
+    // Gimbal model
+    float slew_deg_per_s = 90.0f;
+    float pan_lower_deg = -170.0f;
+    float pan_upper_deg = 170.0f;
+};
+
+/**
+ * Headless stand-in for op-controls firmware
+ * 
+ * Speaks the framed protobuf protocol over TCP and/or a pseudo-terminal,
+ * acks every packet that asks for it, streams Telemetry and applies
+ * commands to a simple slew-limited pan model. Single-threaded: all links
+ * and timers run on one io_context.
+ */
+class GimbalSimulator {
+public:
+    struct Stats {
+        uint64_t packets_received = 0;
+        uint64_t packets_sent = 0;
+        uint64_t acks_sent = 0;
+        uint64_t parse_errors = 0;
+        uint64_t dropped_rx = 0;
+        uint64_t dropped_tx = 0;
+        uint64_t corrupted_tx = 0;
+    };
+    
+    explicit GimbalSimulator(const SimulatorConfig& config);
+    ~GimbalSimulator();
+    
+    GimbalSimulator(const GimbalSimulator&) = delete;
+    GimbalSimulator& operator=(const GimbalSimulator&) = delete;
+    
+    /**
+     * Open the TCP listener and/or PTY
+     */
+    bool start();
+    
+    /**
+     * Run until stop() or SIGINT/SIGTERM
+     */
+    void run();
+    void stop();
+    
+    /**
+     * PTY slave path to point SerialTransport at (empty without --pty)
+     */
+    const std::string& getPtyPath() const { return pty_path_; }
+    
+    boost::asio::io_context& getIoContext() { return io_context_; }
+    
+private:
+    class Link;
+    template <typename Stream> class StreamLink;
+    
+    void startAccept();
+    bool openPty();
+    void addLink(std::shared_ptr<Link> link);
+    void removeLink(Link* link);
+    
+    void handlePacket(Link& link, PacketView packet);
+    void send(Link& link, const op_controls::Envelope& envelope);
+    void sendState(Link& link);
+    
+    void scheduleStream();
+    void streamTick();
+    void advanceModel();
+    void updateModel(double dt);
+    void scheduleStats();
+    
+    bool chance(double probability);
+    
+    SimulatorConfig config_;
+    
+    boost::asio::io_context io_context_;
+    boost::asio::ip::tcp::acceptor acceptor_;
+    boost::asio::steady_timer stream_timer_;
+    boost::asio::steady_timer stats_timer_;
+    boost::asio::signal_set signals_;
+    
+    std::vector<std::shared_ptr<Link>> links_;
+    std::string pty_path_;
+    int pty_slave_fd_;
+    
+    // Reused for every parse/serialize (single-threaded)
+    op_controls::Envelope rx_envelope_;
+    op_controls::Envelope tx_envelope_;
+    
+    std::mt19937 rng_;
+    Stats stats_;
+    
+    // Model state
+    float position_deg_;
+    float setpoint_deg_;
+    op_controls::GimbalMode mode_;
+    bool streaming_;
+    uint32_t stream_rate_hz_;
+    std::chrono::steady_clock::time_point next_tick_;
+    std::chrono::steady_clock::time_point last_update_;
+};
+
+#endif // GIMBAL_SIMULATOR_HPP
@@ -0,0 +1,81 @@
+#include "gimbal_simulator.hpp"
+#include "util/logging.hpp"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+namespace {
+
+void printUsage(const char* program) {
+    std::printf(
+        "Usage: %s [options]\n"
+        "\n"
+        "Stand-in for op-controls firmware, for testing op-gclient without hardware.\n"
+        "\n"
+        "  --tcp-port N     Listen for TCP clients on port N (default 3883, 0 = off)\n"
+        "  --pty            Also serve a pseudo-terminal (connect op-gclient's serial\n"
+        "                   transport to the printed /dev/pts path)\n"
+        "  --pty-link PATH  Symlink PATH to the PTY, e.g. /tmp/ttyGIMBAL\n"
+        "  --rate HZ        Telemetry rate (default 50, max 10000)\n"
+        "  --no-stream      Wait for a StreamControl command before streaming\n"
+        "  --loss P         Drop packets in either direction with probability P (0-1)\n"
+        "  --corrupt P      Flip one bit in sent packets with probability P (0-1)\n"
+        "  --latency MS     Delay everything sent by MS milliseconds\n"
+        "  --jitter MS      Add up to MS milliseconds of random delay (order is kept)\n"
+        "  --seed N         Seed for the impairment/noise generator (default random)\n"
+        "  --help           Show this help\n",
+        program);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    SimulatorConfig config;
+    
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        
+        if (arg == "--help" || arg == "-h") {
+            printUsage(argv[0]);
+            return 0;
+        } else if (arg == "--pty") {
+            config.enable_pty = true;
+        } else if (arg == "--no-stream") {
+            config.stream_on_connect = false;
+        } else if (arg == "--tcp-port" && has_value) {
+            config.tcp_port = static_cast<uint16_t>(std::atoi(argv[++i]));
+        } else if (arg == "--pty-link" && has_value) {
+            config.enable_pty = true;
+            config.pty_link = argv[++i];
+        } else if (arg == "--rate" && has_value) {
+            config.stream_rate_hz = static_cast<uint32_t>(std::atoi(argv[++i]));
+        } else if (arg == "--loss" && has_value) {
+            config.loss = std::atof(argv[++i]);
+        } else if (arg == "--corrupt" && has_value) {
+            config.corruption = std::atof(argv[++i]);
+        } else if (arg == "--latency" && has_value) {
+            config.latency_ms = static_cast<uint32_t>(std::atoi(argv[++i]));
+        } else if (arg == "--jitter" && has_value) {
+            config.jitter_ms = static_cast<uint32_t>(std::atoi(argv[++i]));
+        } else if (arg == "--seed" && has_value) {
+            config.seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else {
+            std::fprintf(stderr, "Unknown or incomplete option: %s\n\n", arg.c_str());
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+    
+    // Console only: the client owns logs/app.log
+    spdlog::set_pattern("[%H:%M:%S.%e] [%^%l%$] %v");
+    
+    GimbalSimulator simulator(config);
+    if (!simulator.start()) {
+        return 1;
+    }
+    
+    simulator.run();
+    return 0;
+}
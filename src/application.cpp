@@ -13,8 +13,7 @@ Application::Application(std::string window_title, int width, int height)
     , window_title_(window_title)
     , window_width_(width)
     , window_height_(height)
-    , gimbal_state_()
-    , comm_backend_(gimbal_state_) {
+    , device_manager_() {
     log_info("=== Application Starting ===");
 }
 
@@ -38,7 +37,7 @@ void Application::initGLFW() {
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
-    
+
 #ifdef __APPLE__
     glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
     log_debug("macOS: Enabled forward compatibility");
@@ -75,7 +74,7 @@ void Application::initImGui() {
     io.ConfigFlags |= ImGuiConfigFlags_DockingEnable;
     io.ConfigFlags |= ImGuiConfigFlags_ViewportsEnable;
     log_debug("ImGui docking and viewports enabled");
-
+    
     // Handle high DPI displays
     float xscale, yscale;
     glfwGetWindowContentScale(window_, &xscale, &yscale);
@@ -88,7 +87,7 @@ void Application::initImGui() {
         style.WindowRounding = 0.0f;
         style.Colors[ImGuiCol_WindowBg].w = 1.0f;
     }
-
+    
     // Scale UI for high DPI BEFORE initializing backends
     if (xscale > 1.0f || yscale > 1.0f) {
         float scale = std::max(xscale, yscale);
@@ -98,7 +97,7 @@ void Application::initImGui() {
     
     ImGui_ImplGlfw_InitForOpenGL(window_, true);
     ImGui_ImplOpenGL3_Init("#version 330");
-
+    
     // Load default font at higher resolution for DPI
     if (xscale > 1.0f || yscale > 1.0f) {
         float scale = std::max(xscale, yscale);
@@ -118,7 +117,7 @@ void Application::initImGui() {
         
         log_debug("Loaded high-DPI font at {}px", font_config.SizePixels);
     }
-
+    
     log_info("ImGui initialized successfully");
 }
 
@@ -127,9 +126,14 @@ void Application::init() {
     initGLFW();
     initGL3W();
     initImGui();
-
-    view_manager_ = std::make_unique<Rendering::ViewManager>(gimbal_state_, comm_backend_);
-
+    
+    view_manager_ = std::make_unique<Rendering::ViewManager>(device_manager_);
+    
+    // Events and new data from the I/O threads wake the main loop
+    Events::EventBus::getInstance().setWakeHandler([this]() {
+        render_scheduler_.requestRedraw();
+    });
+    
     log_info("Application initialized successfully");
 }
 
@@ -138,10 +142,23 @@ void Application::loop() {
     WindowHandler::getInstance().setMainWindow(window_);
     
     while (!glfwWindowShouldClose(window_)) {
-        glfwPollEvents();
+        // Link metrics are sampled once per pass, drawn or not, so while a
+        // link is up the loop must come round every sample interval
+        render_scheduler_.setWakeInterval(device_manager_.anyConnected()
+            ? std::chrono::duration_cast<std::chrono::steady_clock::duration>(MetricsRegistry::SAMPLE_INTERVAL)
+            : std::chrono::steady_clock::duration::zero());
+        
+        // Sleeps until input, new data or the idle deadline
+        bool draw = render_scheduler_.waitForNextFrame(window_);
         
         // Process queued events BEFORE rendering
-        Events::EventQueue::getInstance().pollEvents();
+        Events::EventBus::getInstance().pollEvents();
+        
+        device_manager_.sampleMetrics();
+        
+        if (!draw) {
+            continue;
+        }
         
         ImGui_ImplOpenGL3_NewFrame();
         ImGui_ImplGlfw_NewFrame();
@@ -152,6 +169,11 @@ void Application::loop() {
             view_manager_->render();
         }
         
+        // Dragging or typing: keep frames coming while nothing else changes
+        if (ImGui::IsAnyItemActive()) {
+            render_scheduler_.requestRedraw();
+        }
+        
         ImGui::Render();
         int display_w, display_h;
         glfwGetFramebufferSize(window_, &display_w, &display_h);
@@ -178,18 +200,21 @@ void Application::loop() {
 
 void Application::shutdown() {
     log_debug("Application:: shutdown() called");
-
-    // Disconnect communication (stops I/O threads cleanly)
+    
+    // Disconnect every device (the shared I/O threads stop with the DeviceManager)
     log_debug("Disconnecting communication");
-    comm_backend_.disconnect();
-
+    device_manager_.disconnectAll();
+    
+    // Nothing posts any more; the scheduler goes with this object
+    Events::EventBus::getInstance().setWakeHandler(nullptr);
+    
     // Clear view manager and its event subscriptions
     log_debug("Shutting down ViewManager");
     view_manager_.reset();
     
     // Clear all remaining event subscriptions to prevent static destruction issues
     log_debug("Clearing event queue");
-    Events::EventQueue::getInstance().clearAll();
+    Events::EventBus::getInstance().clearAll();
     
     log_debug("Shutting down ImGui and GLFW");
     ImGui_ImplOpenGL3_Shutdown();
@@ -201,6 +226,6 @@ void Application::shutdown() {
         glfwDestroyWindow(window_);
     }
     glfwTerminate();
-
+    
     log_info("=== Application Shutting Down ===");
 }
@@ -6,8 +6,8 @@
 #include <GL/gl3w.h>
 #include <GLFW/glfw3.h>
 #include "rendering/views.hpp"
-#include "core/gimbal_state.hpp"
-#include "core/communication_backend.hpp"
+#include "rendering/render_scheduler.hpp"
+#include "core/device_manager.hpp"
 
 class Application {
 public:
@@ -20,21 +20,23 @@ public:
     void shutdown();
     
     GLFWwindow* getWindow() { return window_; }
-
-    GimbalState& getGimbalState() { return gimbal_state_; }
-    CommunicationBackend& getCommBackend() { return comm_backend_; }
+    
+    DeviceManager& getDeviceManager() { return device_manager_; }
+    
+    Rendering::RenderScheduler& getRenderScheduler() { return render_scheduler_; }
     
 private:
     GLFWwindow* window_;
     std::string window_title_;
     int window_width_;
     int window_height_;
-
-    GimbalState gimbal_state_;
-    CommunicationBackend comm_backend_;
-
+    
+    DeviceManager device_manager_;      // Every gimbal, on one shared I/O pool
+    
     std::unique_ptr<Rendering::ViewManager> view_manager_;
     
+    Rendering::RenderScheduler render_scheduler_;   // Redraws follow input and data
+    
     void initGLFW();
     void initGL3W();
     void initImGui();
@@ -0,0 +1,160 @@
+#include "core/command_encoder.hpp"
+#include "op_controls.pb.h"
+#include <cstring>
+
+namespace {
+    enum WireType : uint8_t {
+        VARINT = 0,
+        LENGTH_DELIMITED = 2,
+        FIXED32 = 5
+    };
+    
+    constexpr uint8_t tag(uint32_t field, WireType type) {
+        return static_cast<uint8_t>((field << 3) | type);
+    }
+    
+    using op_controls::Envelope;
+    
+    // Envelope
+    constexpr uint8_t PACKET_ID_TAG = tag(1, VARINT);
+    constexpr uint8_t SET_MODE_TAG = tag(6, LENGTH_DELIMITED);
+    constexpr uint8_t POSITION_DEMAND_TAG = tag(7, LENGTH_DELIMITED);
+    constexpr uint8_t STREAM_CONTROL_TAG = tag(8, LENGTH_DELIMITED);
+    constexpr uint8_t REQUEST_STATE_TAG = tag(9, LENGTH_DELIMITED);
+    
+    // Sub-messages
+    constexpr uint8_t SET_MODE_MODE_TAG = tag(1, VARINT);
+    constexpr uint8_t POSITION_DEMAND_PAN_TAG = tag(1, FIXED32);
+    constexpr uint8_t STREAM_CONTROL_ENABLED_TAG = tag(1, VARINT);
+    constexpr uint8_t STREAM_CONTROL_RATE_TAG = tag(2, VARINT);
+    
+    // A hand-written tag that drifts from the .proto fails to build
+    static_assert(Envelope::kPacketIdFieldNumber == 1, "Envelope.packet_id moved");
+    static_assert(Envelope::kSetModeFieldNumber == 6, "Envelope.set_mode moved");
+    static_assert(Envelope::kPositionDemandFieldNumber == 7, "Envelope.position_demand moved");
+    static_assert(Envelope::kStreamControlFieldNumber == 8, "Envelope.stream_control moved");
+    static_assert(Envelope::kRequestStateFieldNumber == 9, "Envelope.request_state moved");
+    static_assert(op_controls::SetMode::kModeFieldNumber == 1, "SetMode.mode moved");
+    static_assert(op_controls::PositionDemand::kPanDegFieldNumber == 1, "PositionDemand.pan_deg moved");
+    static_assert(op_controls::StreamControl::kEnabledFieldNumber == 1, "StreamControl.enabled moved");
+    static_assert(op_controls::StreamControl::kRateHzFieldNumber == 2, "StreamControl.rate_hz moved");
+    
+    // Worst-case sizes: [packet_id tag + varint] [sub tag] [sub length] [sub body]
+    constexpr size_t MAX_VARINT32 = 5;
+    constexpr size_t HEADER_MAX = 1 + MAX_VARINT32 + 2;
+    constexpr size_t SET_MODE_BODY_MAX = 1 + 1;                     // GimbalMode values < 128
+    constexpr size_t POSITION_DEMAND_BODY_MAX = 1 + 4;
+    constexpr size_t STREAM_CONTROL_BODY_MAX = (1 + 1) + (1 + MAX_VARINT32);
+    
+    static_assert(op_controls::GimbalMode_MAX < 0x80, "GimbalMode must encode as one varint byte");
+    static_assert(HEADER_MAX + SET_MODE_BODY_MAX <= PacketCodec::MAX_PAYLOAD_SIZE, "SetMode does not fit a frame");
+    static_assert(HEADER_MAX + POSITION_DEMAND_BODY_MAX <= PacketCodec::MAX_PAYLOAD_SIZE, "PositionDemand does not fit a frame");
+    static_assert(HEADER_MAX + STREAM_CONTROL_BODY_MAX <= PacketCodec::MAX_PAYLOAD_SIZE, "StreamControl does not fit a frame");
+    static_assert(STREAM_CONTROL_BODY_MAX < 0x80, "Sub-message lengths are written as one byte");
+    
+    class Writer {
+    public:
+        explicit Writer(CommandEncoder::Payload& out)
+            : out_(out) {
+            out_.size = 0;
+        }
+        
+        void byte(uint8_t value) {
+            out_.bytes[out_.size++] = value;
+        }
+        
+        void varint(uint32_t value) {
+            while (value >= 0x80) {
+                byte(static_cast<uint8_t>(value | 0x80));
+                value >>= 7;
+            }
+            byte(static_cast<uint8_t>(value));
+        }
+        
+        void fixed32(uint32_t value) {
+            for (int i = 0; i < 4; ++i) {
+                byte(static_cast<uint8_t>(value >> (8 * i)));
+            }
+        }
+        
+        // [packet_id] [tag] [length placeholder]; returns where the body starts
+        size_t begin(uint32_t packet_id, uint8_t message_tag) {
+            if (packet_id != 0) {
+                byte(PACKET_ID_TAG);
+                varint(packet_id);
+            }
+            byte(message_tag);
+            byte(0);
+            return out_.size;
+        }
+        
+        void end(size_t body_start) {
+            out_.bytes[body_start - 1] = static_cast<uint8_t>(out_.size - body_start);
+        }
+    
+    private:
+        CommandEncoder::Payload& out_;
+    };
+    
+    uint32_t toWireMode(GimbalState::Mode mode) {
+        switch (mode) {
+            case GimbalState::Mode::Armed:       return op_controls::GIMBAL_MODE_ARMED;
+            case GimbalState::Mode::LowerLimit:  return op_controls::GIMBAL_MODE_LOWER_LIMIT;
+            case GimbalState::Mode::UpperLimit:  return op_controls::GIMBAL_MODE_UPPER_LIMIT;
+            default:                             return op_controls::GIMBAL_MODE_FREE;
+        }
+    }
+}
+
+CommandEncoder::Payload CommandEncoder::setMode(uint32_t packet_id, GimbalState::Mode mode) {
+    Payload payload;
+    Writer writer(payload);
+    size_t body = writer.begin(packet_id, SET_MODE_TAG);
+    uint32_t wire_mode = toWireMode(mode);
+    if (wire_mode != 0) {
+        writer.byte(SET_MODE_MODE_TAG);
+        writer.varint(wire_mode);
+    }
+    writer.end(body);
+    return payload;
+}
+
+CommandEncoder::Payload CommandEncoder::positionDemand(uint32_t packet_id, float pan_deg) {
+    Payload payload;
+    Writer writer(payload);
+    size_t body = writer.begin(packet_id, POSITION_DEMAND_TAG);
+    
+    // Like protobuf, omit only +0.0 (-0.0 has a non-zero bit pattern)
+    uint32_t bits;
+    static_assert(sizeof(bits) == sizeof(pan_deg), "float must be 32-bit");
+    std::memcpy(&bits, &pan_deg, sizeof(bits));
+    if (bits != 0) {
+        writer.byte(POSITION_DEMAND_PAN_TAG);
+        writer.fixed32(bits);
+    }
+    writer.end(body);
+    return payload;
+}
+
+CommandEncoder::Payload CommandEncoder::streamControl(uint32_t packet_id, bool enabled, uint32_t rate_hz) {
+    Payload payload;
+    Writer writer(payload);
+    size_t body = writer.begin(packet_id, STREAM_CONTROL_TAG);
+    if (enabled) {
+        writer.byte(STREAM_CONTROL_ENABLED_TAG);
+        writer.byte(1);
+    }
+    if (rate_hz != 0) {
+        writer.byte(STREAM_CONTROL_RATE_TAG);
+        writer.varint(rate_hz);
+    }
+    writer.end(body);
+    return payload;
+}
+
+CommandEncoder::Payload CommandEncoder::requestState(uint32_t packet_id) {
+    Payload payload;
+    Writer writer(payload);
+    writer.end(writer.begin(packet_id, REQUEST_STATE_TAG));
+    return payload;
+}
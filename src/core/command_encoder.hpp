@@ -0,0 +1,38 @@
+#ifndef COMMAND_ENCODER_HPP
+#define COMMAND_ENCODER_HPP
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include "core/packet_codec.hpp"
+#include "core/gimbal_state.hpp"
+
+/**
+ * Wire encoding of the client-to-device Envelopes, without protobuf objects
+ * 
+ * Commands are a few fixed-shape messages, so they are written straight
+ * into a stack buffer using precomputed tags. The output is byte-identical
+ * to Envelope::SerializeToArray: proto3 omits fields at their default value.
+ * At compile time the .cpp checks every command's worst-case size against
+ * MAX_PAYLOAD_SIZE and every tag against the generated field numbers.
+ */
+class CommandEncoder {
+public:
+    /**
+     * One serialized Envelope, ready for PacketCodec::encodeInto
+     */
+    struct Payload {
+        std::array<uint8_t, PacketCodec::MAX_PAYLOAD_SIZE> bytes;
+        size_t size = 0;
+        
+        const uint8_t* data() const { return bytes.data(); }
+    };
+    
+    // packet_id 0 = no ack wanted (the field is omitted)
+    static Payload setMode(uint32_t packet_id, GimbalState::Mode mode);
+    static Payload positionDemand(uint32_t packet_id, float pan_deg);
+    static Payload streamControl(uint32_t packet_id, bool enabled, uint32_t rate_hz);
+    static Payload requestState(uint32_t packet_id);
+};
+
+#endif // COMMAND_ENCODER_HPP
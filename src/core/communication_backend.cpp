@@ -1,14 +1,101 @@
 #include "core/communication_backend.hpp"
 #include "util/logging.hpp"
+#include "util/events.hpp"
+#include <algorithm>
+#include <cmath>
+#include <ctime>
+#include <cstdio>
+#include <sstream>
+
+namespace {
+
+/**
+ * Quote a string as a JSON string literal
+ */
+std::string jsonString(const std::string& value) {
+    std::string out;
+    out.reserve(value.size() + 2);
+    out += '"';
+    for (char c : value) {
+        switch (c) {
+            case '"':  out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char escaped[8];
+                    std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned char>(c));
+                    out += escaped;
+                } else {
+                    out += c;
+                }
+        }
+    }
+    out += '"';
+    return out;
+}
+
+} // namespace
 
 CommunicationBackend::CommunicationBackend(GimbalState& gimbal_state)
+    : CommunicationBackend(gimbal_state, nullptr) {
+}
+
+CommunicationBackend::CommunicationBackend(GimbalState& gimbal_state, IoContextPool& pool)
+    : CommunicationBackend(gimbal_state, &pool) {
+}
+
+CommunicationBackend::CommunicationBackend(GimbalState& gimbal_state, IoContextPool* pool)
     : gimbal_state_(gimbal_state)
-    , transport_(std::monostate{}) {  // Start with no transport
+    , dispatcher_(gimbal_state)
+    , route_acks_(false)
+    , link_metrics_(metrics_)
+    , transport_(std::monostate{})  // Start with no transport
+    , socket_profile_(SocketProfile::lowLatency())
+    , pool_(pool)
+    , owned_supervisor_context_(pool ? nullptr : std::make_unique<boost::asio::io_context>())
+    , supervisor_context_(pool ? pool->control() : *owned_supervisor_context_)
+    , supervisor_work_(boost::asio::make_work_guard(supervisor_context_))
+    , reconnect_timer_(supervisor_context_)
+    , link_generation_(0)
+    , reconnecting_(false)
+    , backoff_rng_(std::random_device{}()) {
+    for (auto& failures : command_failures_) {
+        failures.store(0, std::memory_order_relaxed);
+    }
+    if (owned_supervisor_context_) {
+        supervisor_thread_ = std::thread([this]() {
+            log_debug("Link supervisor thread started");
+            supervisor_context_.run();
+            log_debug("Link supervisor thread stopped");
+        });
+    }
     log_debug("CommunicationBackend created");
 }
 
 CommunicationBackend::~CommunicationBackend() {
     disconnect();
+    
+    supervisor_work_.reset();
+    if (owned_supervisor_context_) {
+        supervisor_context_.stop();
+        if (supervisor_thread_.joinable()) {
+            supervisor_thread_.join();
+        }
+    } else {
+        // The control context outlives us: run out anything still queued for
+        // this backend (stale after disconnect(), so it returns at once)
+        runAndDrain(supervisor_context_, [this]() {
+            reconnect_timer_.cancel();
+        });
+    }
+}
+
+boost::asio::io_context* CommunicationBackend::transportIoContext() {
+    // Null: the transport creates its own
+    return pool_ ? &pool_->next() : nullptr;
 }
 
 ITransport* CommunicationBackend::getActiveTransport() {
@@ -42,6 +129,10 @@ CommunicationBackend::TransportType CommunicationBackend::getTransportType() con
             return TransportType::Serial;
         } else if constexpr (std::is_same_v<T, std::unique_ptr<NetworkTransport>>) {
             return TransportType::Network;
+        } else if constexpr (std::is_same_v<T, std::unique_ptr<UdpTransport>>) {
+            return TransportType::Udp;
+        } else if constexpr (std::is_same_v<T, std::unique_ptr<ReplayTransport>>) {
+            return TransportType::Replay;
         }
         return TransportType::None;
     }, transport_);
@@ -53,31 +144,27 @@ bool CommunicationBackend::connectSerial(const std::string& port, uint32_t baud_
     log_info("Connecting to serial: {} @ {} baud", port, baud_rate);
     
     try {
-        auto serial = std::make_unique<SerialTransport>(port, baud_rate);
+        auto serial = std::make_unique<SerialTransport>(port, baud_rate, transportIoContext());
+        serial->setMetrics(&link_metrics_);
         
         if (!serial->open()) {
-            error_message_ = "Failed to open serial port";
-            log_error("{}", error_message_);
+            setErrorMessage("Failed to open serial port");
+            log_error("{}", getErrorMessage());
             return false;
         }
         
-        // Create ACK manager
-        ack_manager_ = std::make_unique<PacketAckManager>(serial->getIoContext());
-        
-        // Set callback (runs on serial I/O thread!)
-        serial->setPacketReceivedCallback([this](const std::vector<uint8_t>& data) {
-            handleReceivedPacket(data);
-        });
+        // Create ACK manager + reliability layer, set callback (runs on serial I/O thread!)
+        attachTransport(*serial);
         
         // Move into variant
-        transport_ = std::move(serial);
-        error_message_.clear();
+        setTransport(std::move(serial));
+        setErrorMessage("");
         
         log_info("Serial connected successfully");
         return true;
-        
+    
     } catch (const std::exception& e) {
-        error_message_ = std::string("Exception: ") + e.what();
+        setErrorMessage(std::string("Exception: ") + e.what());
         log_error("Serial connection failed: {}", e.what());
         return false;
     }
@@ -89,48 +176,118 @@ bool CommunicationBackend::connectNetwork(const std::string& host, uint16_t port
     log_info("Connecting to network: {}:{}", host, port);
     
     try {
-        auto network = std::make_unique<NetworkTransport>(host, port);
+        auto network = std::make_unique<NetworkTransport>(host, port, socket_profile_, transportIoContext());
+        network->setMetrics(&link_metrics_);
+        
+        // Attach first: the ack manager only needs the io_context, and the
+        // receive callback must be in place before the first read
+        attachTransport(*network);
+        setErrorMessage("");
         
-        if (!network->open()) {
-            error_message_ = "Failed to connect to network";
-            log_error("{}", error_message_);
+        // Returns at once; the handler runs on the I/O thread
+        network->openAsync([this](const boost::system::error_code& ec) {
+            if (ec == boost::asio::error::timed_out) {
+                setErrorMessage("Connection timed out");
+            } else if (ec) {
+                setErrorMessage("Failed to connect: " + ec.message());
+            }
+            Events::EventBus::getInstance().notify();
+        }, CONNECT_TIMEOUT);
+        
+        setTransport(std::move(network));
+        return true;
+    
+    } catch (const std::exception& e) {
+        setErrorMessage(std::string("Exception: ") + e.what());
+        log_error("Network connection failed: {}", e.what());
+        return false;
+    }
+}
+
+bool CommunicationBackend::connectUdp(const std::string& host, uint16_t port) {
+    disconnect();
+    
+    log_info("Connecting to network (UDP): {}:{}", host, port);
+    
+    try {
+        auto udp = std::make_unique<UdpTransport>(host, port, transportIoContext());
+        udp->setMetrics(&link_metrics_);
+        
+        if (!udp->open()) {
+            setErrorMessage("Failed to open UDP link");
+            log_error("{}", getErrorMessage());
             return false;
         }
         
-        ack_manager_ = std::make_unique<PacketAckManager>(network->getIoContext());
-        
-        network->setPacketReceivedCallback([this](const std::vector<uint8_t>& data) {
-            handleReceivedPacket(data);
-        });
+        attachTransport(*udp);
         
-        transport_ = std::move(network);
-        error_message_.clear();
+        setTransport(std::move(udp));
+        setErrorMessage("");
         
-        log_info("Network connected successfully");
+        log_info("UDP link open");
         return true;
+    
+    } catch (const std::exception& e) {
+        setErrorMessage(std::string("Exception: ") + e.what());
+        log_error("UDP connection failed: {}", e.what());
+        return false;
+    }
+}
+
+bool CommunicationBackend::connectReplay(const std::string& path, double speed) {
+    disconnect();
+    
+    log_info("Replaying recording: {}", path);
+    
+    try {
+        auto replay = std::make_unique<ReplayTransport>(path, speed);
+        
+        if (!replay->open()) {
+            setErrorMessage("Failed to open recording");
+            log_error("{}", getErrorMessage());
+            return false;
+        }
         
+        attachTransport(*replay, false);
+        
+        setTransport(std::move(replay));
+        setErrorMessage("");
+        
+        log_info("Replay started");
+        return true;
+    
     } catch (const std::exception& e) {
-        error_message_ = std::string("Exception: ") + e.what();
-        log_error("Network connection failed: {}", e.what());
+        setErrorMessage(std::string("Exception: ") + e.what());
+        log_error("Replay failed: {}", e.what());
         return false;
     }
 }
 
 void CommunicationBackend::disconnect() {
-    if (!isConnected()) {
+    // Also tears down a connect that is pending or has failed
+    if (std::holds_alternative<std::monostate>(transport_)) {
         return;
     }
     
     log_info("Disconnecting communication backend");
     
-    if (ack_manager_) {
-        ack_manager_->cancelAll();
-        ack_manager_.reset();
+    // Waits out a reopen in progress; anything the supervisor has queued for
+    // this link is stale from here on
+    std::lock_guard<std::mutex> link_lock(link_mutex_);
+    ++link_generation_;
+    if (reconnecting_.exchange(false)) {
+        std::lock_guard<std::mutex> stats_lock(link_stats_mutex_);
+        link_stats_.reconnecting = false;
+        link_stats_.attempt = 0;
     }
     
+    // Stop the I/O first so no ack or timeout can race the teardown below
     if (auto* transport = getActiveTransport()) {
         transport->close();
+        cancelInFlight(*transport);
     }
+    reliable_channel_.reset();
+    ack_manager_.reset();
     
     transport_ = std::monostate{};  // Clear variant
     gimbal_state_.reset();
@@ -138,6 +295,23 @@ void CommunicationBackend::disconnect() {
     log_info("Communication backend disconnected");
 }
 
+bool CommunicationBackend::isConnecting() const {
+    if (auto* network = std::get_if<std::unique_ptr<NetworkTransport>>(&transport_)) {
+        return (*network)->isConnecting();
+    }
+    return false;
+}
+
+std::string CommunicationBackend::getErrorMessage() const {
+    std::lock_guard<std::mutex> lock(error_mutex_);
+    return error_message_;
+}
+
+void CommunicationBackend::setErrorMessage(const std::string& message) {
+    std::lock_guard<std::mutex> lock(error_mutex_);
+    error_message_ = message;
+}
+
 bool CommunicationBackend::isConnected() const {
     auto* transport = getActiveTransport();
     return transport && transport->isOpen();
@@ -153,31 +327,51 @@ std::string CommunicationBackend::getConnectionInfo() const {
 void CommunicationBackend::sendMessage(const std::vector<uint8_t>& protobuf_data,
                                       std::function<void(bool)> ack_callback,
                                       uint32_t timeout_ms) {
+    sendMessage(protobuf_data.data(), protobuf_data.size(), std::move(ack_callback), timeout_ms);
+}
+
+void CommunicationBackend::sendMessage(const uint8_t* payload, size_t length,
+                                      std::function<void(bool)> ack_callback,
+                                      uint32_t timeout_ms) {
     if (!isConnected()) {
-        log_warn("Cannot send message: not connected");
+        log_warn_limited("Cannot send message: not connected");
         if (ack_callback) {
             ack_callback(false);
         }
         return;
     }
     
+    sendPayload(ack_manager_->getNextPacketId(), payload, length, std::move(ack_callback), timeout_ms);
+}
+
+void CommunicationBackend::sendPayload(uint32_t packet_id, const uint8_t* payload, size_t length,
+                                      std::function<void(bool)> ack_callback,
+                                      uint32_t timeout_ms) {
+    if (ack_callback) {
+        // Time the whole send-to-ack path under the message's type
+        size_t type = MessageDispatcher::peekType(PacketView(payload, length));
+        auto sent = std::chrono::steady_clock::now();
+        ack_callback = [this, type, sent, callback = std::move(ack_callback)](bool success) {
+            recordCommandResult(type, sent, success);
+            callback(success);
+        };
+    }
+    
     // Validate payload size (max 62 bytes to fit in 64-byte packet)
-    if (protobuf_data.size() > PacketCodec::MAX_PAYLOAD_SIZE) {
+    if (length > PacketCodec::MAX_PAYLOAD_SIZE) {
         log_error("Payload too large: {} bytes (max {})", 
-                  protobuf_data.size(), PacketCodec::MAX_PAYLOAD_SIZE);
+                  length, PacketCodec::MAX_PAYLOAD_SIZE);
         if (ack_callback) {
             ack_callback(false);
         }
         return;
     }
     
-    uint32_t packet_id = ack_manager_->getNextPacketId();
-    
     // Encode: [0xAA] [varint length] [payload]
     // For payloads ≤62 bytes, varint is always 1 byte
-    std::vector<uint8_t> encoded_packet;
+    PacketCodec::EncodedPacket encoded_packet;
     try {
-        encoded_packet = codec_.encode(protobuf_data);
+        PacketCodec::encodeInto(payload, length, encoded_packet);
     } catch (const std::exception& e) {
         log_error("Failed to encode packet: {}", e.what());
         if (ack_callback) {
@@ -187,30 +381,429 @@ void CommunicationBackend::sendMessage(const std::vector<uint8_t>& protobuf_data
     }
     
     log_debug("Sending message: packet_id={}, payload_size={}, total_size={}/{}", 
-              packet_id, protobuf_data.size(), encoded_packet.size(), 
+              packet_id, length, encoded_packet.size, 
               PacketCodec::MAX_PACKET_SIZE);
     
+    recorder_.record(TelemetryRecorder::Direction::Sent, payload, length);
+    
     if (ack_callback) {
-        ack_manager_->registerPacket(packet_id, 
-            [ack_callback](bool success, uint32_t id) {
-                ack_callback(success);
-            }, 
-            timeout_ms);
+        // Windowed, retransmitted until acked or timeout_ms elapses
+        reliable_channel_->send(packet_id, encoded_packet, std::move(ack_callback), timeout_ms);
+    } else if (auto* transport = getActiveTransport()) {
+        link_metrics_.packets_out.add();
+        transport->writeAsync(encoded_packet);
+    }
+}
+
+template<typename Encode>
+std::future<bool> CommunicationBackend::sendCommand(const char* name, Encode encode, CommandCallback callback) {
+    auto promise = std::make_shared<std::promise<bool>>();
+    std::future<bool> result = promise->get_future();
+    
+    auto on_ack = [this, name, promise, callback = std::move(callback)](bool success) {
+        // Position demands ack at slider rate: only failures are worth a warning
+        if (success) {
+            log_debug("{} command acked", name);
+        } else {
+            log_warn_limited("{} command failed", name);
+        }
+        Events::EventBus::getInstance().post(Events::CommandEvent{this, name, success});
+        promise->set_value(success);
+        if (callback) {
+            callback(success);
+        }
+    };
+    
+    if (!isConnected()) {
+        log_warn_limited("Cannot send {} command: not connected", name);
+        on_ack(false);
+        return result;
+    }
+    
+    // The id goes into the payload so the firmware's Ack names this command
+    uint32_t packet_id = ack_manager_->getNextPacketId();
+    CommandEncoder::Payload payload = encode(packet_id);
+    sendPayload(packet_id, payload.data(), payload.size, std::move(on_ack), COMMAND_TIMEOUT_MS);
+    return result;
+}
+
+std::future<bool> CommunicationBackend::sendArm(CommandCallback callback) {
+    return sendCommand("ARM", [](uint32_t packet_id) {
+        return CommandEncoder::setMode(packet_id, GimbalState::Mode::Armed);
+    }, std::move(callback));
+}
+
+std::future<bool> CommunicationBackend::sendDisarm(CommandCallback callback) {
+    return sendCommand("DISARM", [](uint32_t packet_id) {
+        return CommandEncoder::setMode(packet_id, GimbalState::Mode::Free);
+    }, std::move(callback));
+}
+
+std::future<bool> CommunicationBackend::sendPositionDemand(float pan_deg, CommandCallback callback) {
+    return sendCommand("Position demand", [pan_deg](uint32_t packet_id) {
+        return CommandEncoder::positionDemand(packet_id, pan_deg);
+    }, std::move(callback));
+}
+
+std::future<bool> CommunicationBackend::setStreaming(bool enabled, uint32_t rate_hz, CommandCallback callback) {
+    return sendCommand(enabled ? "Start streaming" : "Stop streaming", [enabled, rate_hz](uint32_t packet_id) {
+        return CommandEncoder::streamControl(packet_id, enabled, rate_hz);
+    }, std::move(callback));
+}
+
+std::future<bool> CommunicationBackend::setStreamRate(uint32_t rate_hz, CommandCallback callback) {
+    return sendCommand("Stream rate", [rate_hz](uint32_t packet_id) {
+        return CommandEncoder::streamControl(packet_id, true, rate_hz);
+    }, std::move(callback));
+}
+
+void CommunicationBackend::recordCommandResult(size_t type, std::chrono::steady_clock::time_point sent,
+                                               bool success) {
+    if (!success) {
+        command_failures_[type].fetch_add(1, std::memory_order_relaxed);
+        link_metrics_.ack_timeouts.add();
+        return;
+    }
+    auto rtt = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - sent);
+    command_latency_[type].record(static_cast<uint64_t>(rtt.count()));
+}
+
+std::vector<CommunicationBackend::CommandLatency> CommunicationBackend::getCommandLatency() const {
+    std::vector<CommandLatency> result;
+    for (size_t type = 0; type < command_latency_.size(); ++type) {
+        CommandLatency latency;
+        latency.type = MessageDispatcher::typeName(type);
+        latency.rtt = command_latency_[type].summarize();
+        latency.failures = command_failures_[type].load(std::memory_order_relaxed);
+        if (latency.rtt.count > 0 || latency.failures > 0) {
+            result.push_back(latency);
+        }
+    }
+    return result;
+}
+
+void CommunicationBackend::resetCommandLatency() {
+    for (size_t type = 0; type < command_latency_.size(); ++type) {
+        command_latency_[type].reset();
+        command_failures_[type].store(0, std::memory_order_relaxed);
     }
+}
+
+std::string CommunicationBackend::getCommandLatencyJson() const {
+    std::ostringstream out;
+    out.precision(6);
+    
+    char timestamp[32];
+    std::time_t now = std::time(nullptr);
+    std::strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
     
+    out << "{\n";
+    out << "  \"timestamp\": " << jsonString(timestamp) << ",\n";
+    out << "  \"connection\": " << jsonString(getConnectionInfo()) << ",\n";
+    if (getTransportType() == TransportType::Network) {
+        out << "  \"socket_profile\": " << jsonString(socket_profile_.name) << ",\n";
+    }
+    out << "  \"unit\": \"us\",\n";
+    out << "  \"types\": [";
+    
+    bool first = true;
+    for (size_t type = 0; type < command_latency_.size(); ++type) {
+        const LatencyHistogram& histogram = command_latency_[type];
+        LatencyHistogram::Summary rtt = histogram.summarize();
+        uint64_t failures = command_failures_[type].load(std::memory_order_relaxed);
+        if (rtt.count == 0 && failures == 0) {
+            continue;
+        }
+        
+        out << (first ? "\n" : ",\n");
+        first = false;
+        out << "    {\"type\": " << jsonString(MessageDispatcher::typeName(type))
+            << ", \"count\": " << rtt.count << ", \"failures\": " << failures
+            << ", \"min\": " << rtt.min_us << ", \"mean\": " << rtt.mean_us
+            << ", \"p50\": " << rtt.p50_us << ", \"p90\": " << rtt.p90_us
+            << ", \"p99\": " << rtt.p99_us << ", \"p99_9\": " << rtt.p999_us
+            << ", \"max\": " << rtt.max_us << ",\n";
+        
+        // [bucket upper bound, count] for every non-empty bucket
+        out << "     \"buckets\": [";
+        bool first_bucket = true;
+        for (size_t i = 0; i < LatencyHistogram::BUCKETS; ++i) {
+            uint64_t count = histogram.getBucketCount(i);
+            if (count == 0) {
+                continue;
+            }
+            out << (first_bucket ? "" : ", ") << "[" << LatencyHistogram::bucketUpperBound(i) << ", " << count << "]";
+            first_bucket = false;
+        }
+        out << "]}";
+    }
+    
+    out << "\n  ]\n}\n";
+    return out.str();
+}
+
+void CommunicationBackend::setReliabilityConfig(const ReliableChannel::Config& config) {
+    // Applies from the next connection
+    reliability_config_ = config;
+}
+
+bool CommunicationBackend::startRecording(const std::string& path) {
+    return recorder_.start(path);
+}
+
+void CommunicationBackend::stopRecording() {
+    recorder_.stop();
+}
+
+std::optional<ReliableChannel::Stats> CommunicationBackend::getReliabilityStats() const {
+    if (!reliable_channel_) {
+        return std::nullopt;
+    }
+    return reliable_channel_->getStats();
+}
+
+void CommunicationBackend::sampleMetrics() {
+    auto now = std::chrono::steady_clock::now();
+    if (!metrics_.sampleDue(now)) {
+        return;
+    }
+    
+    // Levels the transport and channel already keep are read here, once per
+    // sample, rather than pushed from the I/O thread on every change
+    const ITransport* transport = getActiveTransport();
+    link_metrics_.write_queue_depth.set(transport ? static_cast<double>(transport->getWriteStats().queue_depth) : 0.0);
+    
+    std::optional<ReliableChannel::Stats> reliability = getReliabilityStats();
+    link_metrics_.in_flight.set(reliability ? static_cast<double>(reliability->in_flight) : 0.0);
+    link_metrics_.srtt_ms.set(reliability ? reliability->srtt_ms : 0.0);
+    
+    metrics_.sample(now);
+}
+
+std::optional<ReplayTransport::Stats> CommunicationBackend::getReplayStats() const {
+    if (auto* replay = std::get_if<std::unique_ptr<ReplayTransport>>(&transport_)) {
+        return (*replay)->getReplayStats();
+    }
+    return std::nullopt;
+}
+
+void CommunicationBackend::setTransport(TransportVariant transport) {
+    // The supervisor reads transport_ under this lock
+    std::lock_guard<std::mutex> lock(link_mutex_);
+    transport_ = std::move(transport);
+}
+
+void CommunicationBackend::attachTransport(ITransport& transport, bool route_acks) {
+    ack_manager_ = std::make_unique<PacketAckManager>(transport.getIoContext());
+    route_acks_ = route_acks;
+    
+    ITransport* writer = &transport;
+    Counter* packets_out = &link_metrics_.packets_out;
+    reliable_channel_ = std::make_unique<ReliableChannel>(*ack_manager_,
+        [writer, packets_out](const PacketCodec::EncodedPacket& packet) {
+            packets_out->add();
+            writer->writeAsync(packet);
+        },
+        reliability_config_);
+    
+    transport.setPacketReceivedCallback([this](PacketView packet) {
+        handleReceivedPacket(packet);
+    });
+    
+    // Runs on the I/O thread, which the supervisor will join; hand it over
+    uint64_t generation = link_generation_;
+    transport.setLinkLostCallback([this, generation](const std::string& reason) {
+        boost::asio::post(supervisor_context_, [this, generation, reason]() {
+            handleLinkLost(generation, reason);
+        });
+    });
+}
+
+void CommunicationBackend::cancelInFlight(ITransport& transport) {
+    auto cancel = [this]() {
+        // Channel first: its in-flight packets must not be retransmitted when
+        // the ack manager cancels their timeouts
+        if (reliable_channel_) {
+            reliable_channel_->cancelAll();
+        }
+        if (ack_manager_) {
+            ack_manager_->cancelAll();
+        }
+    };
+    
+    // A closed transport's own context is stopped. A pool context keeps
+    // running, so cancel on it and let the ack manager's aborted tick run
+    // before the caller can destroy it.
+    boost::asio::io_context& io_context = transport.getIoContext();
+    if (pool_ && !io_context.stopped()) {
+        runAndDrain(io_context, cancel);
+    } else {
+        cancel();
+    }
+}
+
+void CommunicationBackend::setReconnectPolicy(const ReconnectPolicy& policy) {
+    boost::asio::post(supervisor_context_, [this, policy]() {
+        reconnect_policy_ = policy;
+    });
+}
+
+CommunicationBackend::LinkStats CommunicationBackend::getLinkStats() const {
+    std::lock_guard<std::mutex> lock(link_stats_mutex_);
+    return link_stats_;
+}
+
+void CommunicationBackend::handleLinkLost(uint64_t generation, const std::string& reason) {
+    std::lock_guard<std::mutex> lock(link_mutex_);
+    if (generation != link_generation_) {
+        return;
+    }
+    
+    log_warn("Link lost: {}", reason);
+    link_lost_time_ = std::chrono::steady_clock::now();
+    Events::EventBus::getInstance().post(Events::LinkEvent{this, Events::LinkEvent::Kind::Lost});
+    
+    // Stop the dead link's I/O, then fail everything in flight now rather
+    // than at each packet's timeout (same order as disconnect())
     if (auto* transport = getActiveTransport()) {
-        transport->writeAsync(encoded_packet);
+        transport->close();
+        cancelInFlight(*transport);
+    }
+    
+    {
+        std::lock_guard<std::mutex> stats_lock(link_stats_mutex_);
+        link_stats_.link_losses++;
+        link_stats_.last_loss_reason = reason;
+        link_stats_.reconnecting = reconnect_policy_.enabled;
+        link_stats_.attempt = 0;
+    }
+    
+    if (!reconnect_policy_.enabled) {
+        setErrorMessage(reason);
+        return;
+    }
+    
+    reconnecting_ = true;
+    scheduleReconnect(generation);
+}
+
+void CommunicationBackend::scheduleReconnect(uint64_t generation) {
+    uint32_t attempt;
+    {
+        std::lock_guard<std::mutex> stats_lock(link_stats_mutex_);
+        attempt = link_stats_.attempt;
+    }
+    
+    // 0, d, d*m, d*m^2, ... capped, each scaled by 1 ± jitter so a rack of
+    // clients does not hammer a rebooting device in lockstep
+    std::chrono::milliseconds delay{0};
+    if (attempt > 0) {
+        double base = reconnect_policy_.initial_delay.count() *
+                      std::pow(reconnect_policy_.multiplier, static_cast<double>(attempt - 1));
+        base = std::min(base, static_cast<double>(reconnect_policy_.max_delay.count()));
+        std::uniform_real_distribution<double> jitter(1.0 - reconnect_policy_.jitter, 1.0 + reconnect_policy_.jitter);
+        delay = std::chrono::milliseconds(static_cast<int64_t>(base * jitter(backoff_rng_)));
+    }
+    
+    reconnect_timer_.expires_after(delay);
+    reconnect_timer_.async_wait([this, generation](const boost::system::error_code& ec) {
+        if (!ec) {
+            attemptReconnect(generation);
+        }
+    });
+}
+
+void CommunicationBackend::attemptReconnect(uint64_t generation) {
+    std::lock_guard<std::mutex> lock(link_mutex_);
+    if (generation != link_generation_) {
+        return;
+    }
+    
+    uint32_t attempt;
+    {
+        std::lock_guard<std::mutex> stats_lock(link_stats_mutex_);
+        attempt = ++link_stats_.attempt;
+    }
+    log_info("Reconnecting to {} (attempt {})", getConnectionInfo(), attempt);
+    
+    // Same transport object: it keeps its io_context, so the ack manager's
+    // timer and the reliable channel stay bound to it
+    if (auto* network = std::get_if<std::unique_ptr<NetworkTransport>>(&transport_)) {
+        (*network)->close();
+        (*network)->openAsync([this, generation](const boost::system::error_code& ec) {
+            bool success = !ec;
+            boost::asio::post(supervisor_context_, [this, generation, success]() {
+                std::lock_guard<std::mutex> lock(link_mutex_);
+                finishReconnect(generation, success);
+            });
+        }, CONNECT_TIMEOUT);
+        return;
+    }
+    
+    bool success = false;
+    if (auto* transport = getActiveTransport()) {
+        transport->close();
+        success = transport->open();
+    }
+    finishReconnect(generation, success);
+}
+
+void CommunicationBackend::finishReconnect(uint64_t generation, bool success) {
+    // Called with link_mutex_ held
+    if (generation != link_generation_) {
+        return;
     }
+    
+    if (!success) {
+        scheduleReconnect(generation);
+        return;
+    }
+    
+    double recovery_s = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - link_lost_time_).count();
+    
+    uint32_t attempts;
+    {
+        std::lock_guard<std::mutex> stats_lock(link_stats_mutex_);
+        attempts = link_stats_.attempt;
+        link_stats_.reconnecting = false;
+        link_stats_.attempt = 0;
+        link_stats_.recoveries++;
+        link_stats_.last_recovery_s = recovery_s;
+        link_stats_.max_recovery_s = std::max(link_stats_.max_recovery_s, recovery_s);
+    }
+    reconnecting_ = false;
+    link_metrics_.reconnects.add();
+    Events::EventBus::getInstance().post(Events::LinkEvent{this, Events::LinkEvent::Kind::Recovered});
+    setErrorMessage("");
+    
+    log_info("Link recovered in {:.0f} ms after {} attempt{}", recovery_s * 1000.0,
+             attempts, attempts == 1 ? "" : "s");
+    
+    // Whatever the firmware did while we were away, start from its truth
+    requestFullState();
 }
 
-void CommunicationBackend::handleReceivedPacket(const std::vector<uint8_t>& packet_data) {
-    log_debug("Received packet: {} bytes", packet_data.size());
-    decodeAndProcessMessage(packet_data);
+void CommunicationBackend::requestFullState() {
+    // Fire-and-forget: the replies are the confirmation
+    CommandEncoder::Payload payload = CommandEncoder::requestState(0);
+    sendMessage(payload.data(), payload.size);
 }
 
-void CommunicationBackend::decodeAndProcessMessage(const std::vector<uint8_t>& data) {
-    // TODO: Parse protobuf matching op-controls feat/protobuf-commands
-    // This updates gimbal_state_ (thread-safe via mutex)
+void CommunicationBackend::handleReceivedPacket(PacketView packet) {
+    log_debug("Received packet: {} bytes", packet.size());
+    link_metrics_.packets_in.add();
+    recorder_.record(TelemetryRecorder::Direction::Received, packet.data(), packet.size());
+    decodeAndProcessMessage(packet);
     
-    log_debug("Message processed");
+    // New telemetry or an ack to show
+    Events::EventBus::getInstance().notify();
+}
+
+void CommunicationBackend::decodeAndProcessMessage(PacketView payload) {
+    // The ack manager only changes while the transport is closed, so it is
+    // stable for the duration of this I/O-thread callback
+    if (!dispatcher_.dispatch(payload, route_acks_ ? ack_manager_.get() : nullptr)) {
+        link_metrics_.parse_errors.add();
+    }
 }
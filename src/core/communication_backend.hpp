@@ -7,66 +7,243 @@
 #include <cstdint>
 #include <variant>
 #include <optional>
+#include <mutex>
+#include <chrono>
+#include <atomic>
+#include <random>
+#include <thread>
+#include <future>
+#include <boost/asio.hpp>
 #include "core/transport_interface.hpp"
 #include "core/serial_transport.hpp"
 #include "core/network_transport.hpp"
+#include "core/udp_transport.hpp"
+#include "core/replay_transport.hpp"
 #include "core/packet_codec.hpp"
 #include "core/packet_ack_manager.hpp"
+#include "core/reliable_channel.hpp"
 #include "core/gimbal_state.hpp"
+#include "core/telemetry_recorder.hpp"
+#include "core/io_context_pool.hpp"
+#include "core/message_dispatcher.hpp"
+#include "core/command_encoder.hpp"
+#include "core/latency_histogram.hpp"
+#include "core/metrics.hpp"
 
 /**
  * Communication backend with variant transport
  * Runs on transport's I/O thread, NOT the GUI thread
+ * 
+ * A supervisor thread watches for the transport reporting a lost link and
+ * reopens it with jittered exponential backoff, then asks the firmware for
+ * its full state. Explicit connect*()/disconnect() always win over it.
+ * 
+ * Standalone, a backend owns its supervisor thread and each transport its
+ * I/O thread. Built on an IoContextPool (one backend per gimbal), transports
+ * run on the pool's I/O contexts and supervision on its control context,
+ * so many links cost no extra threads. Replays always have their own.
+ * 
+ * Link loss and recovery are posted to the GUI as Events::LinkEvent.
  */
 class CommunicationBackend {
 public:
     enum class TransportType {
         None,
         Serial,
-        Network
+        Network,
+        Udp,
+        Replay
     };
     
     explicit CommunicationBackend(GimbalState& gimbal_state);
+    CommunicationBackend(GimbalState& gimbal_state, IoContextPool& pool);
     ~CommunicationBackend();
     
     // Delete copy/move
     CommunicationBackend(const CommunicationBackend&) = delete;
     CommunicationBackend& operator=(const CommunicationBackend&) = delete;
     
+    // Give up on resolve + connect after this long
+    static constexpr std::chrono::milliseconds CONNECT_TIMEOUT{5000};
+    
+    struct ReconnectPolicy {
+        bool enabled = true;
+        std::chrono::milliseconds initial_delay{50};    // Delay before the 2nd attempt (1st is immediate)
+        std::chrono::milliseconds max_delay{2000};
+        double multiplier = 2.0;
+        double jitter = 0.25;                           // Each delay is scaled by 1 ± jitter
+    };
+    
+    struct LinkStats {
+        bool reconnecting = false;
+        uint32_t attempt = 0;               // Attempts in the current outage
+        uint64_t link_losses = 0;
+        uint64_t recoveries = 0;
+        double last_recovery_s = 0.0;       // Link lost -> reopened (0 until the first recovery)
+        double max_recovery_s = 0.0;
+        std::string last_loss_reason;
+    };
+    
     // Connection management
     bool connectSerial(const std::string& port, uint32_t baud_rate);
+    // Returns immediately; watch isConnecting()/isConnected()/getErrorMessage()
     bool connectNetwork(const std::string& host, uint16_t port);
+    bool connectUdp(const std::string& host, uint16_t port);
+    bool connectReplay(const std::string& path, double speed = 1.0);  // speed 0 = as fast as possible
     void disconnect();
     
     // Status queries
     bool isConnected() const;
+    bool isConnecting() const;
+    bool isReconnecting() const { return reconnecting_; }
     TransportType getTransportType() const;
     std::string getConnectionInfo() const;
-    std::string getErrorMessage() const { return error_message_; }
+    std::string getErrorMessage() const;
     
     // Communication
+    // With an ack_callback the message is delivered through the reliability
+    // window and retransmitted until acked or timeout_ms elapses
     void sendMessage(const std::vector<uint8_t>& protobuf_data,
                     std::function<void(bool success)> ack_callback = nullptr,
                     uint32_t timeout_ms = 1000);
+    void sendMessage(const uint8_t* payload, size_t length,
+                    std::function<void(bool success)> ack_callback = nullptr,
+                    uint32_t timeout_ms = 1000);
+    
+    // Typed commands: encoded in place (CommandEncoder) with their packet_id
+    // in Envelope field 1, and sent through the reliability window. The
+    // future and the optional callback (run on the I/O thread) get true once
+    // the firmware acks, false on timeout or if not connected. The result is
+    // also posted to the GUI as an Events::CommandEvent.
+    using CommandCallback = std::function<void(bool success)>;
+    static constexpr uint32_t COMMAND_TIMEOUT_MS = 1000;
+    
+    std::future<bool> sendArm(CommandCallback callback = nullptr);
+    std::future<bool> sendDisarm(CommandCallback callback = nullptr);
+    std::future<bool> sendPositionDemand(float pan_deg, CommandCallback callback = nullptr);
+    // rate_hz 0 keeps the firmware's current rate
+    std::future<bool> setStreaming(bool enabled, uint32_t rate_hz = 0, CommandCallback callback = nullptr);
+    // Streams at rate_hz (the firmware has no rate-only command, so this also starts streaming)
+    std::future<bool> setStreamRate(uint32_t rate_hz, CommandCallback callback = nullptr);
+    
+    // TCP options for the next connectNetwork() (Nagle, buffers, keepalive)
+    void setSocketProfile(const SocketProfile& profile) { socket_profile_ = profile; }
+    const SocketProfile& getSocketProfile() const { return socket_profile_; }
+    
+    // Automatic reconnection after a lost link (serial and TCP)
+    void setReconnectPolicy(const ReconnectPolicy& policy);
+    LinkStats getLinkStats() const;
+    
+    // Reliability tuning (window size, retries, RTO bounds)
+    void setReliabilityConfig(const ReliableChannel::Config& config);
+    std::optional<ReliableChannel::Stats> getReliabilityStats() const;
+    
+    // Send-to-ack round trip of acked messages by Envelope type, timed from
+    // the sendMessage()/send*() call (so including window queueing and
+    // retransmits). Cumulative across connections until reset.
+    struct CommandLatency {
+        const char* type;
+        LatencyHistogram::Summary rtt;
+        uint64_t failures = 0;              // Timed out or cancelled
+    };
+    std::vector<CommandLatency> getCommandLatency() const;     // Types with any samples or failures
+    void resetCommandLatency();
+    // Summaries plus non-empty buckets, tagged with the current connection
+    std::string getCommandLatencyJson() const;
+    
+    // Received messages by type, parse errors (cumulative across connections)
+    MessageDispatcher::Stats getMessageStats() const { return dispatcher_.getStats(); }
+    
+    // Live link metrics (LinkMetrics: byte and packet rates, errors, queue
+    // levels), cumulative across connections. GUI thread only: call
+    // sampleMetrics() at least every MetricsRegistry::SAMPLE_INTERVAL (more
+    // often is fine, it samples at that interval).
+    void sampleMetrics();
+    const MetricsRegistry& getMetrics() const { return metrics_; }
+    
+    // Progress and achieved rate while a replay is the active transport
+    std::optional<ReplayTransport::Stats> getReplayStats() const;
+    
+    // Binary recording of every received and sent payload (independent of
+    // the connection, so it spans reconnects)
+    bool startRecording(const std::string& path);
+    void stopRecording();
+    bool isRecording() const { return recorder_.isRecording(); }
+    TelemetryRecorder::Stats getRecordingStats() const { return recorder_.getStats(); }
+    std::string getRecordingPath() const { return recorder_.getPath(); }
     
 private:
-    void handleReceivedPacket(const std::vector<uint8_t>& packet_data);
-    void decodeAndProcessMessage(const std::vector<uint8_t>& data);
+    CommunicationBackend(GimbalState& gimbal_state, IoContextPool* pool);
+    
+    boost::asio::io_context* transportIoContext();
+    void attachTransport(ITransport& transport, bool route_acks = true);
+    void cancelInFlight(ITransport& transport);
+    void handleReceivedPacket(PacketView packet);
+    void decodeAndProcessMessage(PacketView payload);
+    void sendPayload(uint32_t packet_id, const uint8_t* payload, size_t length,
+                     std::function<void(bool success)> ack_callback, uint32_t timeout_ms);
+    void recordCommandResult(size_t type, std::chrono::steady_clock::time_point sent, bool success);
+    
+    template<typename Encode>
+    std::future<bool> sendCommand(const char* name, Encode encode, CommandCallback callback);
+    void setErrorMessage(const std::string& message);
+    
+    // Supervisor thread
+    void handleLinkLost(uint64_t generation, const std::string& reason);
+    void scheduleReconnect(uint64_t generation);
+    void attemptReconnect(uint64_t generation);
+    void finishReconnect(uint64_t generation, bool success);
+    void requestFullState();
     
     GimbalState& gimbal_state_;
+    MessageDispatcher dispatcher_;          // dispatch() runs on the I/O thread
+    std::atomic<bool> route_acks_;          // Off for replays: recorded acks are not for our packets
+    MetricsRegistry metrics_;
+    LinkMetrics link_metrics_;              // Registered in metrics_, updated from the I/O thread
     
     // Variant holds exactly ONE transport at a time
     using TransportVariant = std::variant<
         std::monostate,  // None/disconnected
         std::unique_ptr<SerialTransport>,
-        std::unique_ptr<NetworkTransport>
+        std::unique_ptr<NetworkTransport>,
+        std::unique_ptr<UdpTransport>,
+        std::unique_ptr<ReplayTransport>
     >;
     
+    void setTransport(TransportVariant transport);
+    
     TransportVariant transport_;
     std::unique_ptr<PacketAckManager> ack_manager_;
-    PacketCodec codec_;
+    std::unique_ptr<ReliableChannel> reliable_channel_;
+    ReliableChannel::Config reliability_config_;
+    SocketProfile socket_profile_;
+    TelemetryRecorder recorder_;
+    
+    // Indexed by Envelope msg_case (MessageDispatcher::peekType)
+    std::array<LatencyHistogram, MessageDispatcher::MESSAGE_TYPES> command_latency_;
+    std::array<std::atomic<uint64_t>, MessageDispatcher::MESSAGE_TYPES> command_failures_;
+    
+    std::string error_message_;             // Also written by the I/O thread on connect failure
+    mutable std::mutex error_mutex_;
+    
+    // Reconnect supervision. link_mutex_ serialises transport teardown (GUI
+    // thread) against reopen (supervisor); link_generation_ changes on every
+    // disconnect so queued supervisor work for an old link is dropped.
+    IoContextPool* pool_;                                           // Null when standalone
+    std::unique_ptr<boost::asio::io_context> owned_supervisor_context_;
+    boost::asio::io_context& supervisor_context_;                   // Owned, or the pool's control()
+    boost::asio::executor_work_guard<boost::asio::io_context::executor_type> supervisor_work_;
+    boost::asio::steady_timer reconnect_timer_;
+    std::thread supervisor_thread_;                                 // Only when standalone
+    std::mutex link_mutex_;
+    uint64_t link_generation_;
+    std::atomic<bool> reconnecting_;
+    std::chrono::steady_clock::time_point link_lost_time_;
+    std::mt19937 backoff_rng_;
     
-    std::string error_message_;
+    ReconnectPolicy reconnect_policy_;
+    LinkStats link_stats_;
+    mutable std::mutex link_stats_mutex_;
     
     // Helper to get active transport interface
     ITransport* getActiveTransport();
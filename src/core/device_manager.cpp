@@ -0,0 +1,58 @@
+#include "core/device_manager.hpp"
+#include "util/logging.hpp"
+
+DeviceManager::DeviceManager(size_t io_threads)
+    : pool_(io_threads) {
+}
+
+DeviceManager::~DeviceManager() {
+    disconnectAll();
+    devices_.clear();
+}
+
+size_t DeviceManager::addDevice(const std::string& name) {
+    auto device = std::make_unique<Device>();
+    device->name = name;
+    device->state = std::make_unique<GimbalState>();
+    device->backend = std::make_unique<CommunicationBackend>(*device->state, pool_);
+    devices_.push_back(std::move(device));
+    
+    log_info("Added device '{}' ({} total)", name, devices_.size());
+    return devices_.size() - 1;
+}
+
+void DeviceManager::removeDevice(size_t index) {
+    if (index >= devices_.size()) {
+        log_warn("No device {} to remove", index);
+        return;
+    }
+    
+    log_info("Removing device '{}'", devices_[index]->name);
+    
+    // Backend before state: it writes into the state until disconnected
+    devices_[index]->backend.reset();
+    devices_.erase(devices_.begin() + static_cast<std::ptrdiff_t>(index));
+}
+
+void DeviceManager::disconnectAll() {
+    for (auto& device : devices_) {
+        device->backend->disconnect();
+    }
+}
+
+bool DeviceManager::anyConnected() const {
+    for (const auto& device : devices_) {
+        if (device->backend->isConnected()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void DeviceManager::sampleMetrics() {
+    // Every device, not just the one on screen, so no history is missing
+    // when its diagnostics are opened
+    for (auto& device : devices_) {
+        device->backend->sampleMetrics();
+    }
+}
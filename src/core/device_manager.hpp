@@ -0,0 +1,69 @@
+#ifndef DEVICE_MANAGER_HPP
+#define DEVICE_MANAGER_HPP
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "core/io_context_pool.hpp"
+#include "core/gimbal_state.hpp"
+#include "core/communication_backend.hpp"
+
+/**
+ * Every gimbal the client talks to, each with its own state and backend
+ * 
+ * All backends share one IoContextPool, so dozens of links run on a
+ * handful of I/O threads instead of one (plus a supervisor) per link.
+ * Called from the GUI thread only.
+ */
+class DeviceManager {
+public:
+    struct Device {
+        std::string name;
+        std::unique_ptr<GimbalState> state;
+        std::unique_ptr<CommunicationBackend> backend;
+    };
+    
+    /**
+     * @param io_threads Size of the shared I/O pool, 0 = one per hardware thread
+     */
+    explicit DeviceManager(size_t io_threads = 0);
+    ~DeviceManager();
+    
+    DeviceManager(const DeviceManager&) = delete;
+    DeviceManager& operator=(const DeviceManager&) = delete;
+    
+    /**
+     * Add a disconnected device
+     * @return Its index
+     */
+    size_t addDevice(const std::string& name);
+    
+    /**
+     * Disconnect and remove a device; later indices shift down by one
+     */
+    void removeDevice(size_t index);
+    
+    size_t getDeviceCount() const { return devices_.size(); }
+    Device& getDevice(size_t index) { return *devices_.at(index); }
+    const Device& getDevice(size_t index) const { return *devices_.at(index); }
+    
+    IoContextPool& getPool() { return pool_; }
+    
+    void disconnectAll();
+    
+    /**
+     * Whether any device has a live link
+     */
+    bool anyConnected() const;
+    
+    /**
+     * Sample every device's link metrics (see CommunicationBackend::sampleMetrics)
+     */
+    void sampleMetrics();
+    
+private:
+    IoContextPool pool_;    // Declared first: outlives every backend
+    std::vector<std::unique_ptr<Device>> devices_;
+};
+
+#endif // DEVICE_MANAGER_HPP
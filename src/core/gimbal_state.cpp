@@ -1,78 +1,129 @@
 #include "core/gimbal_state.hpp"
+#include <cstring>
+
+GimbalState::GimbalState()
+    : sequence_(0) {
+    publish();
+}
+
+bool GimbalState::Snapshot::isStale(std::chrono::milliseconds timeout_ms) const {
+    auto now = std::chrono::steady_clock::now();
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - last_update_time);
+    return elapsed > timeout_ms;
+}
+
+GimbalState::Snapshot GimbalState::getSnapshot() const {
+    std::array<uint64_t, SNAPSHOT_WORDS> buffer;
+    uint32_t begin;
+    uint32_t end;
+    
+    do {
+        begin = sequence_.load(std::memory_order_acquire);
+        for (size_t i = 0; i < SNAPSHOT_WORDS; ++i) {
+            buffer[i] = words_[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        end = sequence_.load(std::memory_order_relaxed);
+    } while ((begin & 1) != 0 || begin != end);
+    
+    Snapshot snapshot;
+    std::memcpy(static_cast<void*>(&snapshot), buffer.data(), sizeof(Snapshot));
+    return snapshot;
+}
+
+void GimbalState::publish() {
+    // Called with write_mutex_ held (or from the constructor)
+    std::array<uint64_t, SNAPSHOT_WORDS> buffer{};
+    std::memcpy(buffer.data(), &staged_, sizeof(Snapshot));
+    
+    uint32_t sequence = sequence_.load(std::memory_order_relaxed);
+    sequence_.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    
+    for (size_t i = 0; i < SNAPSHOT_WORDS; ++i) {
+        words_[i].store(buffer[i], std::memory_order_relaxed);
+    }
+    
+    sequence_.store(sequence + 2, std::memory_order_release);
+}
 
 GimbalState::Position GimbalState::getPosition() const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return position_;
+    return getSnapshot().position;
 }
 
 GimbalState::Setpoint GimbalState::getSetpoint() const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return setpoint_;
+    return getSnapshot().setpoint;
 }
 
 GimbalState::Mode GimbalState::getMode() const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return mode_;
+    return getSnapshot().mode;
 }
 
 GimbalState::Limits GimbalState::getLimits() const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return limits_;
+    return getSnapshot().limits;
 }
 
 GimbalState::Health GimbalState::getHealth() const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return health_;
+    return getSnapshot().health;
 }
 
 std::chrono::steady_clock::time_point GimbalState::getLastUpdateTime() const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return last_update_time_;
+    return getSnapshot().last_update_time;
 }
 
 void GimbalState::setPosition(const Position& position) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    position_ = position;
-    last_update_time_ = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    staged_.position = position;
+    staged_.last_update_time = std::chrono::steady_clock::now();
+    publish();
+    history_.append(position.pan_deg, staged_.setpoint.pan_deg);
 }
 
 void GimbalState::setSetpoint(const Setpoint& setpoint) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    setpoint_ = setpoint;
-    last_update_time_ = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    staged_.setpoint = setpoint;
+    staged_.last_update_time = std::chrono::steady_clock::now();
+    publish();
 }
 
 void GimbalState::setMode(Mode mode) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    mode_ = mode;
-    last_update_time_ = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    staged_.mode = mode;
+    staged_.last_update_time = std::chrono::steady_clock::now();
+    publish();
 }
 
 void GimbalState::setLimits(const Limits& limits) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    limits_ = limits;
-    last_update_time_ = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    staged_.limits = limits;
+    staged_.last_update_time = std::chrono::steady_clock::now();
+    publish();
 }
 
 void GimbalState::setHealth(const Health& health) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    health_ = health;
-    last_update_time_ = std::chrono::steady_clock::now();
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    staged_.health = health;
+    staged_.last_update_time = std::chrono::steady_clock::now();
+    publish();
+}
+
+void GimbalState::setTelemetry(const Position& position, const Setpoint& setpoint, Mode mode) {
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    staged_.position = position;
+    staged_.setpoint = setpoint;
+    staged_.mode = mode;
+    staged_.last_update_time = std::chrono::steady_clock::now();
+    publish();
+    history_.append(position.pan_deg, setpoint.pan_deg);
 }
 
 bool GimbalState::isStale(std::chrono::milliseconds timeout_ms) const {
-    std::lock_guard<std::mutex> lock(mutex_);
-    auto now = std::chrono::steady_clock::now();
-    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - last_update_time_);
-    return elapsed > timeout_ms;
+    return getSnapshot().isStale(timeout_ms);
 }
 
 void GimbalState::reset() {
-    std::lock_guard<std::mutex> lock(mutex_);
-    position_ = Position{};
-    setpoint_ = Setpoint{};
-    mode_ = Mode::Free;
-    limits_ = Limits{};
-    health_ = Health{};
-    last_update_time_ = std::chrono::steady_clock::time_point{};
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    staged_ = Snapshot{};
+    publish();
+    history_.clear();
 }
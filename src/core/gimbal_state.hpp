@@ -2,12 +2,23 @@
 #define GIMBAL_STATE_HPP
 
 #include <mutex>
+#include <atomic>
+#include <array>
 #include <cstdint>
 #include <chrono>
-#include <string>
+#include <type_traits>
+#include "core/telemetry_history.hpp"
 
 /**
  * Thread-safe gimbal state matching op-controls firmware
+ * 
+ * Published through a seqlock: readers copy a complete, consistent
+ * Snapshot without taking a lock (retrying only if they overlapped a
+ * write), so the GUI thread never contends with the I/O thread and the
+ * I/O thread never waits behind a slow frame. Writers are serialised by
+ * a mutex that readers never touch.
+ * 
+ * Every position update is also appended to a TelemetryHistory for plotting.
  */
 class GimbalState {
 public:
@@ -44,16 +55,33 @@ public:
             Error
         };
         Status status = Status::Unknown;
-        std::string message;
+        char message[48] = {};  // Fixed-size so the state stays trivially copyable
         uint32_t error_flags = 0;
     };
     
-    GimbalState() = default;
+    /**
+     * Complete, consistent copy of the state at one instant
+     */
+    struct Snapshot {
+        Position position;
+        Setpoint setpoint;
+        Mode mode = Mode::Free;
+        Limits limits;
+        Health health;
+        std::chrono::steady_clock::time_point last_update_time;
+        
+        bool isStale(std::chrono::milliseconds timeout_ms = std::chrono::milliseconds(500)) const;
+    };
+    
+    GimbalState();
     ~GimbalState() = default;
     
     GimbalState(const GimbalState&) = delete;
     GimbalState& operator=(const GimbalState&) = delete;
     
+    // Lock-free read of the whole state (preferred: one call per frame)
+    Snapshot getSnapshot() const;
+    
     // Thread-safe getters
     Position getPosition() const;
     Setpoint getSetpoint() const;
@@ -69,18 +97,32 @@ public:
     void setLimits(const Limits& limits);
     void setHealth(const Health& health);
     
+    // One telemetry frame: a single publish, and the history sample pairs
+    // the position with the setpoint from the same frame
+    void setTelemetry(const Position& position, const Setpoint& setpoint, Mode mode);
+    
     bool isStale(std::chrono::milliseconds timeout_ms = std::chrono::milliseconds(500)) const;
     void reset();
     
+    // Full-rate position/setpoint history (lock-free reads)
+    const TelemetryHistory& getHistory() const { return history_; }
+    
 private:
-    mutable std::mutex mutex_;
-    
-    Position position_;
-    Setpoint setpoint_;
-    Mode mode_ = Mode::Free;
-    Limits limits_;
-    Health health_;
-    std::chrono::steady_clock::time_point last_update_time_;
+    static constexpr size_t SNAPSHOT_WORDS = (sizeof(Snapshot) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+    
+    void publish();
+    
+    std::mutex write_mutex_;   // Serialises writers only
+    Snapshot staged_;          // Writer-side copy, guarded by write_mutex_
+    
+    // Seqlock: odd sequence = write in progress
+    std::atomic<uint32_t> sequence_;
+    std::array<std::atomic<uint64_t>, SNAPSHOT_WORDS> words_;
+    
+    TelemetryHistory history_;  // Appended under write_mutex_ (single writer)
 };
 
+static_assert(std::is_trivially_copyable_v<GimbalState::Snapshot>, 
+              "Snapshot is copied word-wise by the seqlock");
+
 #endif // GIMBAL_STATE_HPP
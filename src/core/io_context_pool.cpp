@@ -0,0 +1,76 @@
+#include "core/io_context_pool.hpp"
+#include "util/logging.hpp"
+#include <boost/asio/post.hpp>
+#include <algorithm>
+#include <future>
+
+IoContextPool::Worker::Worker()
+    : work_guard(boost::asio::make_work_guard(context)) {
+}
+
+IoContextPool::IoContextPool(size_t threads)
+    : next_(0) {
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    
+    auto start = [](Worker& worker, size_t index) {
+        worker.thread = std::thread([&worker, index]() {
+            log_debug("I/O pool thread {} started", index);
+            worker.context.run();
+            log_debug("I/O pool thread {} stopped", index);
+        });
+    };
+    
+    workers_.reserve(threads);
+    for (size_t i = 0; i < threads; ++i) {
+        workers_.push_back(std::make_unique<Worker>());
+        start(*workers_.back(), i);
+    }
+    control_ = std::make_unique<Worker>();
+    start(*control_, threads);
+    
+    log_info("I/O pool started with {} thread{} (+1 control)", threads, threads == 1 ? "" : "s");
+}
+
+IoContextPool::~IoContextPool() {
+    stop();
+}
+
+boost::asio::io_context& IoContextPool::next() {
+    return workers_[next_.fetch_add(1, std::memory_order_relaxed) % workers_.size()]->context;
+}
+
+void IoContextPool::stop() {
+    auto halt = [](Worker& worker) {
+        worker.work_guard.reset();
+        worker.context.stop();
+        if (worker.thread.joinable()) {
+            worker.thread.join();
+        }
+    };
+    
+    // Control first: it may be waiting on the I/O contexts
+    halt(*control_);
+    for (auto& worker : workers_) {
+        halt(*worker);
+    }
+}
+
+void runAndDrain(boost::asio::io_context& io_context, const std::function<void()>& fn) {
+    if (io_context.get_executor().running_in_this_thread()) {
+        fn();
+        return;
+    }
+    
+    // Completions made ready by fn are queued before the fence fn posts, and
+    // the context is single-threaded, so they have all run when it fires
+    std::promise<void> drained;
+    boost::asio::post(io_context, [&io_context, &fn, &drained]() {
+        fn();
+        boost::asio::post(io_context, [&drained]() {
+            drained.set_value();
+        });
+    });
+    drained.get_future().wait();
+}
@@ -0,0 +1,73 @@
+#ifndef IO_CONTEXT_POOL_HPP
+#define IO_CONTEXT_POOL_HPP
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/executor_work_guard.hpp>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+/**
+ * Small fixed set of I/O threads shared by many transports
+ * 
+ * One io_context per thread (not one context run by N threads), so every
+ * handler of a transport bound to a context runs on the same thread, in
+ * order, exactly as with a transport-owned io_context. Transports are
+ * spread over the contexts round-robin.
+ * 
+ * A separate control context runs work that blocks on the I/O contexts
+ * (closing and reopening transports), which must never run on them.
+ */
+class IoContextPool {
+public:
+    /**
+     * @param threads Number of I/O threads, 0 = one per hardware thread
+     */
+    explicit IoContextPool(size_t threads = 0);
+    ~IoContextPool();
+    
+    IoContextPool(const IoContextPool&) = delete;
+    IoContextPool& operator=(const IoContextPool&) = delete;
+    
+    /**
+     * I/O context for the next transport (round-robin)
+     */
+    boost::asio::io_context& next();
+    
+    /**
+     * Context for blocking supervision work (reconnects)
+     */
+    boost::asio::io_context& control() { return control_->context; }
+    
+    size_t size() const { return workers_.size(); }
+    
+    /**
+     * Stop and join all threads (also done by the destructor)
+     */
+    void stop();
+    
+private:
+    struct Worker {
+        boost::asio::io_context context;
+        boost::asio::executor_work_guard<boost::asio::io_context::executor_type> work_guard;
+        std::thread thread;
+        
+        Worker();
+    };
+    
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::unique_ptr<Worker> control_;
+    std::atomic<size_t> next_;
+};
+
+/**
+ * Run fn on a running io_context and wait until it, and every completion
+ * it made ready (e.g. handlers of operations it cancelled), has run. After
+ * this returns no handler queued by fn can still touch its objects.
+ * Runs fn inline if already on that context's thread.
+ */
+void runAndDrain(boost::asio::io_context& io_context, const std::function<void()>& fn);
+
+#endif // IO_CONTEXT_POOL_HPP
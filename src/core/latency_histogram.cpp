@@ -0,0 +1,120 @@
+#include "core/latency_histogram.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+    unsigned highestBit(uint64_t value) {
+        unsigned bit = 0;
+        while (value >>= 1) {
+            ++bit;
+        }
+        return bit;
+    }
+    
+    // Lock-free min/max: retry only while another thread moves the bound our way
+    void raiseTo(std::atomic<uint64_t>& bound, uint64_t value) {
+        uint64_t current = bound.load(std::memory_order_relaxed);
+        while (value > current && !bound.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+        }
+    }
+    
+    void lowerTo(std::atomic<uint64_t>& bound, uint64_t value) {
+        uint64_t current = bound.load(std::memory_order_relaxed);
+        while (value < current && !bound.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+        }
+    }
+}
+
+LatencyHistogram::LatencyHistogram()
+    : total_count_(0)
+    , total_us_(0)
+    , min_us_(std::numeric_limits<uint64_t>::max())
+    , max_us_(0) {
+    for (auto& count : counts_) {
+        count.store(0, std::memory_order_relaxed);
+    }
+}
+
+size_t LatencyHistogram::bucketIndex(uint64_t value_us) {
+    value_us = std::min(value_us, MAX_VALUE_US);
+    if (value_us < SUB_BUCKETS) {
+        return static_cast<size_t>(value_us);
+    }
+    
+    // Keep the top SUB_BUCKET_BITS bits: mantissa in [SUB_BUCKETS/2, SUB_BUCKETS)
+    unsigned shift = highestBit(value_us) - SUB_BUCKET_BITS + 1;
+    uint64_t mantissa = value_us >> shift;
+    return static_cast<size_t>(SUB_BUCKETS + (shift - 1) * (SUB_BUCKETS / 2) + (mantissa - SUB_BUCKETS / 2));
+}
+
+uint64_t LatencyHistogram::bucketUpperBound(size_t index) {
+    if (index < SUB_BUCKETS) {
+        return index;
+    }
+    
+    uint64_t offset = index - SUB_BUCKETS;
+    unsigned shift = static_cast<unsigned>(offset / (SUB_BUCKETS / 2)) + 1;
+    uint64_t mantissa = offset % (SUB_BUCKETS / 2) + SUB_BUCKETS / 2;
+    return ((mantissa + 1) << shift) - 1;
+}
+
+void LatencyHistogram::record(uint64_t value_us) {
+    value_us = std::min(value_us, MAX_VALUE_US);
+    counts_[bucketIndex(value_us)].fetch_add(1, std::memory_order_relaxed);
+    total_count_.fetch_add(1, std::memory_order_relaxed);
+    total_us_.fetch_add(value_us, std::memory_order_relaxed);
+    lowerTo(min_us_, value_us);
+    raiseTo(max_us_, value_us);
+}
+
+uint64_t LatencyHistogram::valueAtPercentile(double percentile) const {
+    // Sum the buckets rather than trusting total_count_, which may be ahead of them
+    uint64_t count = 0;
+    for (const auto& bucket : counts_) {
+        count += bucket.load(std::memory_order_relaxed);
+    }
+    if (count == 0) {
+        return 0;
+    }
+    
+    percentile = std::clamp(percentile, 0.0, 100.0);
+    uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(percentile / 100.0 * count)));
+    
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKETS; ++i) {
+        seen += counts_[i].load(std::memory_order_relaxed);
+        if (seen >= rank) {
+            // The bucket bound can exceed the largest value actually recorded
+            return std::min(bucketUpperBound(i), max_us_.load(std::memory_order_relaxed));
+        }
+    }
+    return max_us_.load(std::memory_order_relaxed);
+}
+
+LatencyHistogram::Summary LatencyHistogram::summarize() const {
+    Summary summary;
+    summary.count = total_count_.load(std::memory_order_relaxed);
+    if (summary.count == 0) {
+        return summary;
+    }
+    
+    summary.min_us = min_us_.load(std::memory_order_relaxed);
+    summary.max_us = max_us_.load(std::memory_order_relaxed);
+    summary.mean_us = static_cast<double>(total_us_.load(std::memory_order_relaxed)) / summary.count;
+    summary.p50_us = valueAtPercentile(50.0);
+    summary.p90_us = valueAtPercentile(90.0);
+    summary.p99_us = valueAtPercentile(99.0);
+    summary.p999_us = valueAtPercentile(99.9);
+    return summary;
+}
+
+void LatencyHistogram::reset() {
+    for (auto& count : counts_) {
+        count.store(0, std::memory_order_relaxed);
+    }
+    total_count_.store(0, std::memory_order_relaxed);
+    total_us_.store(0, std::memory_order_relaxed);
+    min_us_.store(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+    max_us_.store(0, std::memory_order_relaxed);
+}
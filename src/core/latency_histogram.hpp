@@ -0,0 +1,69 @@
+#ifndef LATENCY_HISTOGRAM_HPP
+#define LATENCY_HISTOGRAM_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * Lock-free, fixed-memory latency histogram (HDR-style log-linear buckets)
+ * 
+ * Values are microseconds. Below SUB_BUCKETS every value has its own
+ * bucket; above, each power of two is split into SUB_BUCKETS / 2 linear
+ * buckets, so any recorded value is known to within 1/32 (about 3 %) up to
+ * MAX_VALUE_US. Larger values are clamped.
+ * 
+ * record() is a few relaxed atomic adds and never blocks, so it can run on
+ * the I/O thread. summarize() and reset() may run concurrently with it; a
+ * summary taken meanwhile can be off by the samples still in flight.
+ */
+class LatencyHistogram {
+public:
+    static constexpr unsigned SUB_BUCKET_BITS = 6;
+    static constexpr uint64_t SUB_BUCKETS = uint64_t{1} << SUB_BUCKET_BITS;    // 64
+    static constexpr unsigned MAX_VALUE_BITS = 27;                              // ~134 s
+    static constexpr uint64_t MAX_VALUE_US = (uint64_t{1} << MAX_VALUE_BITS) - 1;
+    static constexpr size_t BUCKETS =
+        SUB_BUCKETS + (MAX_VALUE_BITS - SUB_BUCKET_BITS) * (SUB_BUCKETS / 2);
+    
+    struct Summary {
+        uint64_t count = 0;
+        uint64_t min_us = 0;
+        uint64_t max_us = 0;
+        double mean_us = 0.0;
+        // Upper bound of the bucket holding each percentile (never understated)
+        uint64_t p50_us = 0;
+        uint64_t p90_us = 0;
+        uint64_t p99_us = 0;
+        uint64_t p999_us = 0;
+    };
+    
+    LatencyHistogram();
+    
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+    
+    void record(uint64_t value_us);
+    Summary summarize() const;
+    void reset();
+    
+    /**
+     * Upper bound of the value at a percentile (0-100), 0 if empty
+     */
+    uint64_t valueAtPercentile(double percentile) const;
+    
+    // Bucket mapping (exposed for exporters and the benchmark)
+    static size_t bucketIndex(uint64_t value_us);
+    static uint64_t bucketUpperBound(size_t index);
+    uint64_t getBucketCount(size_t index) const { return counts_[index].load(std::memory_order_relaxed); }
+    
+private:
+    std::array<std::atomic<uint64_t>, BUCKETS> counts_;
+    std::atomic<uint64_t> total_count_;
+    std::atomic<uint64_t> total_us_;
+    std::atomic<uint64_t> min_us_;
+    std::atomic<uint64_t> max_us_;
+};
+
+#endif // LATENCY_HISTOGRAM_HPP
@@ -0,0 +1,174 @@
+#include "core/message_dispatcher.hpp"
+#include "util/logging.hpp"
+#include "op_controls.pb.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+    using Envelope = op_controls::Envelope;
+    using Handler = void (*)(const Envelope&, MessageDispatcher::Targets&);
+    
+    GimbalState::Mode toMode(op_controls::GimbalMode mode) {
+        switch (mode) {
+            case op_controls::GIMBAL_MODE_ARMED:        return GimbalState::Mode::Armed;
+            case op_controls::GIMBAL_MODE_LOWER_LIMIT:  return GimbalState::Mode::LowerLimit;
+            case op_controls::GIMBAL_MODE_UPPER_LIMIT:  return GimbalState::Mode::UpperLimit;
+            default:                                    return GimbalState::Mode::Free;
+        }
+    }
+    
+    GimbalState::Health::Status toStatus(op_controls::HealthStatus status) {
+        switch (status) {
+            case op_controls::HEALTH_STATUS_HEALTHY:    return GimbalState::Health::Status::Healthy;
+            case op_controls::HEALTH_STATUS_WARNING:    return GimbalState::Health::Status::Warning;
+            case op_controls::HEALTH_STATUS_ERROR:      return GimbalState::Health::Status::Error;
+            default:                                    return GimbalState::Health::Status::Unknown;
+        }
+    }
+    
+    void handleAck(const Envelope& envelope, MessageDispatcher::Targets& targets) {
+        if (targets.ack_manager) {
+            targets.ack_manager->handleAck(envelope.ack().packet_id());
+        }
+    }
+    
+    void handleTelemetry(const Envelope& envelope, MessageDispatcher::Targets& targets) {
+        const auto& telemetry = envelope.telemetry();
+        GimbalState::Position position;
+        position.pan_deg = telemetry.pan_position_deg();
+        GimbalState::Setpoint setpoint;
+        setpoint.pan_deg = telemetry.pan_setpoint_deg();
+        targets.gimbal_state.setTelemetry(position, setpoint, toMode(telemetry.mode()));
+    }
+    
+    void handleLimits(const Envelope& envelope, MessageDispatcher::Targets& targets) {
+        // Tilt limits are not on the wire yet: keep whatever is there
+        GimbalState::Limits limits = targets.gimbal_state.getLimits();
+        limits.pan_lower = envelope.limits().pan_lower_deg();
+        limits.pan_upper = envelope.limits().pan_upper_deg();
+        targets.gimbal_state.setLimits(limits);
+    }
+    
+    void handleHealth(const Envelope& envelope, MessageDispatcher::Targets& targets) {
+        const auto& message = envelope.health();
+        GimbalState::Health health;
+        health.status = toStatus(message.status());
+        health.error_flags = message.error_flags();
+        size_t length = std::min(message.message().size(), sizeof(health.message) - 1);
+        std::memcpy(health.message, message.message().data(), length);
+        targets.gimbal_state.setHealth(health);
+    }
+    
+    constexpr std::array<Handler, MessageDispatcher::MESSAGE_TYPES> makeHandlers() {
+        std::array<Handler, MessageDispatcher::MESSAGE_TYPES> handlers{};
+        handlers[Envelope::kAck] = &handleAck;
+        handlers[Envelope::kTelemetry] = &handleTelemetry;
+        handlers[Envelope::kLimits] = &handleLimits;
+        handlers[Envelope::kHealth] = &handleHealth;
+        return handlers;
+    }
+    
+    constexpr auto HANDLERS = makeHandlers();
+    
+    // msg_case() indexes the table unchecked
+    static_assert(Envelope::kRequestState + 1 == MessageDispatcher::MESSAGE_TYPES,
+                  "MESSAGE_TYPES must cover every Envelope oneof field");
+    
+    google::protobuf::ArenaOptions arenaOptions(char* block, size_t size) {
+        google::protobuf::ArenaOptions options;
+        options.initial_block = block;
+        options.initial_block_size = size;
+        return options;
+    }
+}
+
+MessageDispatcher::MessageDispatcher(GimbalState& gimbal_state)
+    : gimbal_state_(gimbal_state)
+    , arena_(arenaOptions(arena_block_.data(), arena_block_.size()))
+    , envelope_(google::protobuf::Arena::CreateMessage<op_controls::Envelope>(&arena_))
+    , received_(0)
+    , parse_errors_(0)
+    , unhandled_(0) {
+    for (auto& count : by_type_) {
+        count.store(0, std::memory_order_relaxed);
+    }
+}
+
+MessageDispatcher::~MessageDispatcher() = default;
+
+void MessageDispatcher::resetArena() {
+    // Frees nothing back to the heap: the arena falls back to arena_block_
+    arena_.Reset();
+    envelope_ = google::protobuf::Arena::CreateMessage<op_controls::Envelope>(&arena_);
+}
+
+bool MessageDispatcher::dispatch(PacketView payload, PacketAckManager* ack_manager) {
+    received_.fetch_add(1, std::memory_order_relaxed);
+    
+    // Switching oneof cases leaves the old sub-message on the arena
+    if (arena_.SpaceUsed() > ARENA_BYTES / 2) {
+        resetArena();
+    }
+    
+    if (!envelope_->ParseFromArray(payload.data(), static_cast<int>(payload.size()))) {
+        parse_errors_.fetch_add(1, std::memory_order_relaxed);
+        log_warn_limited("Dropping unparseable {}-byte message", payload.size());
+        return false;
+    }
+    
+    size_t type = static_cast<size_t>(envelope_->msg_case());
+    by_type_[type].fetch_add(1, std::memory_order_relaxed);
+    
+    Handler handler = HANDLERS[type];
+    if (!handler) {
+        unhandled_.fetch_add(1, std::memory_order_relaxed);
+        log_debug("No handler for message type {}", type);
+        return true;
+    }
+    
+    Targets targets{gimbal_state_, ack_manager};
+    handler(*envelope_, targets);
+    return true;
+}
+
+size_t MessageDispatcher::peekType(PacketView payload) {
+    const uint8_t* data = payload.data();
+    size_t size = payload.size();
+    size_t pos = 0;
+    
+    // Every field of Envelope has a one-byte tag
+    if (pos < size && data[pos] == ((Envelope::kPacketIdFieldNumber << 3) | 0)) {
+        ++pos;
+        while (pos < size && (data[pos] & 0x80)) {
+            ++pos;
+        }
+        ++pos;
+    }
+    if (pos >= size) {
+        return 0;
+    }
+    
+    size_t field = data[pos] >> 3;
+    return field > Envelope::kPacketIdFieldNumber && field < MESSAGE_TYPES ? field : 0;
+}
+
+const char* MessageDispatcher::typeName(size_t type) {
+    static_assert(Envelope::kAck == 2 && Envelope::kHealth == 5 && Envelope::kRequestState == 9,
+                  "NAMES follows the oneof field numbers");
+    static const char* const NAMES[MESSAGE_TYPES] = {
+        "none", "packet_id", "ack", "telemetry", "limits", "health",
+        "set_mode", "position_demand", "stream_control", "request_state"
+    };
+    return type < MESSAGE_TYPES ? NAMES[type] : "unknown";
+}
+
+MessageDispatcher::Stats MessageDispatcher::getStats() const {
+    Stats stats;
+    stats.received = received_.load(std::memory_order_relaxed);
+    stats.parse_errors = parse_errors_.load(std::memory_order_relaxed);
+    stats.unhandled = unhandled_.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < MESSAGE_TYPES; ++i) {
+        stats.by_type[i] = by_type_[i].load(std::memory_order_relaxed);
+    }
+    return stats;
+}
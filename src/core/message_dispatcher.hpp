@@ -0,0 +1,89 @@
+#ifndef MESSAGE_DISPATCHER_HPP
+#define MESSAGE_DISPATCHER_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <google/protobuf/arena.h>
+#include "core/packet_view.hpp"
+#include "core/gimbal_state.hpp"
+#include "core/packet_ack_manager.hpp"
+
+namespace op_controls {
+class Envelope;
+}
+
+/**
+ * Decodes received Envelopes and routes them by message type
+ * 
+ * Parses straight from the framed payload into one Envelope that lives on
+ * an arena carved from a member buffer, and is reused for every message;
+ * the arena is reset (not freed) once alternating message types have used
+ * half of it. Telemetry and acks therefore decode without touching the heap.
+ * 
+ * Routing is a constexpr table indexed by Envelope::msg_case(), filled in
+ * the .cpp. Client-to-device types have no entry and are counted as
+ * unhandled. Runs on the transport's I/O thread only.
+ */
+class MessageDispatcher {
+public:
+    static constexpr size_t MESSAGE_TYPES = 10;     // Envelope oneof field numbers 0..9
+    static constexpr size_t ARENA_BYTES = 4096;
+    
+    struct Stats {
+        uint64_t received = 0;
+        uint64_t parse_errors = 0;
+        uint64_t unhandled = 0;                     // Empty or client-to-device messages
+        std::array<uint64_t, MESSAGE_TYPES> by_type{};  // Parsed messages, indexed by msg_case()
+    };
+    
+    explicit MessageDispatcher(GimbalState& gimbal_state);
+    ~MessageDispatcher();
+    
+    MessageDispatcher(const MessageDispatcher&) = delete;
+    MessageDispatcher& operator=(const MessageDispatcher&) = delete;
+    
+    /**
+     * Parse one payload and apply it
+     * @param ack_manager Receives acks; null while no link is attached
+     * @return false if the payload is not a valid Envelope
+     */
+    bool dispatch(PacketView payload, PacketAckManager* ack_manager);
+    
+    Stats getStats() const;
+    
+    /**
+     * Message type (msg_case) of a serialized Envelope without parsing it:
+     * the field after an optional packet_id. 0 if it cannot tell.
+     */
+    static size_t peekType(PacketView payload);
+    
+    /**
+     * Oneof field name for a type, e.g. "position_demand"
+     */
+    static const char* typeName(size_t type);
+    
+    /**
+     * Everything a handler may update
+     */
+    struct Targets {
+        GimbalState& gimbal_state;
+        PacketAckManager* ack_manager;
+    };
+    
+private:
+    void resetArena();
+    
+    GimbalState& gimbal_state_;
+    
+    alignas(std::max_align_t) std::array<char, ARENA_BYTES> arena_block_;
+    google::protobuf::Arena arena_;
+    op_controls::Envelope* envelope_;   // Owned by arena_
+    
+    std::atomic<uint64_t> received_;
+    std::atomic<uint64_t> parse_errors_;
+    std::atomic<uint64_t> unhandled_;
+    std::array<std::atomic<uint64_t>, MESSAGE_TYPES> by_type_;
+};
+
+#endif // MESSAGE_DISPATCHER_HPP
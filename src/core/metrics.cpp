@@ -0,0 +1,103 @@
+#include "core/metrics.hpp"
+#include <algorithm>
+
+Counter& MetricsRegistry::counter(const char* name, const char* unit) {
+    return add(name, unit, Kind::Counter).counter;
+}
+
+Counter& MetricsRegistry::rate(const char* name, const char* unit) {
+    return add(name, unit, Kind::Rate).counter;
+}
+
+Gauge& MetricsRegistry::gauge(const char* name, const char* unit) {
+    return add(name, unit, Kind::Gauge).gauge;
+}
+
+MetricsRegistry::Metric& MetricsRegistry::add(const char* name, const char* unit, Kind kind) {
+    auto metric = std::make_unique<Metric>();
+    metric->name = name;
+    metric->unit = unit;
+    metric->kind = kind;
+    metrics_.push_back(std::move(metric));
+    return *metrics_.back();
+}
+
+bool MetricsRegistry::sampleDue(std::chrono::steady_clock::time_point now) const {
+    return !sampled_ || now - last_sample_ >= SAMPLE_INTERVAL;
+}
+
+bool MetricsRegistry::sample(std::chrono::steady_clock::time_point now) {
+    if (!sampleDue(now)) {
+        return false;
+    }
+    
+    double elapsed_s = sampled_ ? std::chrono::duration<double>(now - last_sample_).count() : 0.0;
+    
+    for (auto& metric : metrics_) {
+        double value = 0.0;
+        switch (metric->kind) {
+            case Kind::Counter:
+                value = static_cast<double>(metric->counter.get());
+                break;
+            
+            case Kind::Rate: {
+                uint64_t count = metric->counter.get();
+                if (elapsed_s > 0.0) {
+                    value = static_cast<double>(count - metric->last_count) / elapsed_s;
+                }
+                metric->last_count = count;
+                break;
+            }
+            
+            case Kind::Gauge:
+                value = metric->gauge.get();
+                break;
+        }
+        
+        metric->history[metric->head] = static_cast<float>(value);
+        metric->head = (metric->head + 1) % HISTORY;
+        metric->filled = std::min(metric->filled + 1, HISTORY);
+    }
+    
+    last_sample_ = now;
+    sampled_ = true;
+    return true;
+}
+
+MetricsRegistry::Series MetricsRegistry::getSeries(size_t index) const {
+    const Metric& metric = *metrics_[index];
+    
+    Series series;
+    series.name = metric.name;
+    series.unit = metric.unit;
+    series.kind = metric.kind;
+    series.total = metric.kind == Kind::Gauge
+        ? metric.gauge.get()
+        : static_cast<double>(metric.counter.get());
+    series.history = metric.history.data();
+    series.count = metric.filled;
+    
+    // Until the ring wraps the oldest sample is slot 0
+    series.offset = metric.filled < HISTORY ? 0 : metric.head;
+    
+    if (metric.filled > 0) {
+        series.current = metric.history[(metric.head + HISTORY - 1) % HISTORY];
+        series.peak = *std::max_element(metric.history.begin(), metric.history.begin() + metric.filled);
+    }
+    return series;
+}
+
+LinkMetrics::LinkMetrics(MetricsRegistry& registry)
+    : bytes_in(registry.rate("Bytes in", "B/s"))
+    , bytes_out(registry.rate("Bytes out", "B/s"))
+    , packets_in(registry.rate("Packets in", "pkt/s"))
+    , packets_out(registry.rate("Packets out", "pkt/s"))
+    , framing_errors(registry.counter("Framing errors", ""))
+    , dropped_bytes(registry.counter("Dropped bytes", "B"))
+    , parse_errors(registry.counter("Parse errors", ""))
+    , ack_timeouts(registry.counter("Ack timeouts", ""))
+    , reconnects(registry.counter("Reconnects", ""))
+    , write_queue_depth(registry.gauge("Write queue depth", "pkt"))
+    , in_flight(registry.gauge("In flight", "pkt"))
+    , srtt_ms(registry.gauge("Smoothed RTT", "ms")) {
+}
@@ -0,0 +1,145 @@
+#ifndef METRICS_HPP
+#define METRICS_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+/**
+ * Monotonic event/byte count
+ * 
+ * add() is one relaxed atomic add, so any thread may update it without a
+ * lock. Each counter sits on its own cache line so counters bumped by the
+ * I/O thread do not bounce lines read or written by other threads.
+ */
+class alignas(64) Counter {
+public:
+    void add(uint64_t n = 1) { value_.fetch_add(n, std::memory_order_relaxed); }
+    uint64_t get() const { return value_.load(std::memory_order_relaxed); }
+    
+private:
+    std::atomic<uint64_t> value_{0};
+};
+
+/**
+ * Current level of something (queue depth, RTT)
+ */
+class alignas(64) Gauge {
+public:
+    void set(double value) { value_.store(value, std::memory_order_relaxed); }
+    double get() const { return value_.load(std::memory_order_relaxed); }
+    
+private:
+    std::atomic<double> value_{0.0};
+};
+
+/**
+ * Named counters, rate meters and gauges with a short sampled history
+ * 
+ * Metrics are registered once, before the threads that update them start,
+ * and never removed, so components keep plain references to them and the
+ * hot path is a relaxed atomic add or store with no lookup.
+ * 
+ * sample() runs on the GUI thread: at most every SAMPLE_INTERVAL it reads
+ * every metric once and appends to its history ring, which is what the
+ * diagnostics view plots. A rate meter is a counter whose history is its
+ * per-second rate between samples. Only the sampling thread may call
+ * sample() and getSeries().
+ */
+class MetricsRegistry {
+public:
+    static constexpr size_t HISTORY = 300;                                   // Samples per metric
+    static constexpr std::chrono::milliseconds SAMPLE_INTERVAL{100};         // 30 s of history
+    
+    enum class Kind {
+        Counter,    // Plots the running total
+        Rate,       // Plots the per-second rate of a counter
+        Gauge       // Plots the value
+    };
+    
+    struct Series {
+        const char* name;
+        const char* unit;
+        Kind kind;
+        double total = 0.0;                 // Counter value (counters and rates), else the gauge
+        double current = 0.0;               // Latest sample: total, rate or gauge value
+        double peak = 0.0;                  // Largest sample in the history
+        const float* history = nullptr;     // Ring of count samples, oldest at offset
+        size_t count = 0;
+        size_t offset = 0;
+    };
+    
+    MetricsRegistry() = default;
+    
+    MetricsRegistry(const MetricsRegistry&) = delete;
+    MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+    
+    // Registration (setup only)
+    Counter& counter(const char* name, const char* unit);
+    Counter& rate(const char* name, const char* unit);     // unit is per second
+    Gauge& gauge(const char* name, const char* unit);
+    
+    /**
+     * Whether sample(now) would take a sample
+     */
+    bool sampleDue(std::chrono::steady_clock::time_point now) const;
+    
+    /**
+     * Take a sample if SAMPLE_INTERVAL has passed since the last one
+     * @return true if a sample was taken
+     */
+    bool sample(std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now());
+    
+    size_t size() const { return metrics_.size(); }
+    Series getSeries(size_t index) const;
+    
+private:
+    struct Metric {
+        const char* name;
+        const char* unit;
+        Kind kind;
+        Counter counter;
+        Gauge gauge;
+        
+        // Sampler state
+        uint64_t last_count = 0;
+        std::array<float, HISTORY> history{};
+        size_t head = 0;                    // Next slot to write
+        size_t filled = 0;
+    };
+    
+    Metric& add(const char* name, const char* unit, Kind kind);
+    
+    std::vector<std::unique_ptr<Metric>> metrics_;
+    std::chrono::steady_clock::time_point last_sample_;
+    bool sampled_ = false;
+};
+
+/**
+ * The link metrics every CommunicationBackend registers, in display order
+ * 
+ * Transports and the framer get a pointer to this (ITransport::setMetrics)
+ * and skip the update while it is null.
+ */
+struct LinkMetrics {
+    Counter& bytes_in;          // Raw bytes read, before framing
+    Counter& bytes_out;         // Bytes the transport has written
+    Counter& packets_in;        // Framed packets delivered to the backend
+    Counter& packets_out;       // Packets handed to the transport, retransmissions included
+    Counter& framing_errors;    // Bad length bytes, malformed datagrams
+    Counter& dropped_bytes;     // Noise skipped while hunting for a sync byte
+    Counter& parse_errors;      // Framed payloads that were not a valid Envelope
+    Counter& ack_timeouts;      // Acked sends that failed (timed out, or cut off by a lost link)
+    Counter& reconnects;        // Links reopened by the supervisor
+    Gauge& write_queue_depth;
+    Gauge& in_flight;           // Reliability window occupancy
+    Gauge& srtt_ms;
+    
+    explicit LinkMetrics(MetricsRegistry& registry);
+};
+
+#endif // METRICS_HPP
@@ -1,19 +1,31 @@
 #include "core/network_transport.hpp"
+#include "core/io_context_pool.hpp"
 #include "util/logging.hpp"
+#include <iterator>
 
-NetworkTransport::NetworkTransport(const std::string& host, uint16_t port)
+NetworkTransport::NetworkTransport(const std::string& host, uint16_t port, const SocketProfile& profile,
+                                   boost::asio::io_context* shared_io_context)
     : host_(host)
     , port_(port)
+    , profile_(profile)
+    , owned_io_context_(shared_io_context ? nullptr : std::make_unique<boost::asio::io_context>())
+    , io_context_(shared_io_context ? *shared_io_context : *owned_io_context_)
     , socket_(io_context_)
+    , resolver_(io_context_)
+    , connect_timer_(io_context_)
+    , connect_timed_out_(false)
     , work_guard_(boost::asio::make_work_guard(io_context_))
-    , framer_([this](const std::vector<uint8_t>& packet) {
+    , io_active_(false)
+    , framer_([this](PacketView packet) {
           // Framer delivers complete packets
           std::lock_guard<std::mutex> lock(callback_mutex_);
           if (packet_callback_) {
               packet_callback_(packet);
           }
       })
-    , is_connected_(false) {
+    , metrics_(nullptr)
+    , is_connected_(false)
+    , connecting_(false) {
 }
 
 NetworkTransport::~NetworkTransport() {
@@ -33,15 +45,22 @@ bool NetworkTransport::open() {
         boost::asio::ip::tcp::resolver resolver(io_context_);
         auto endpoints = resolver.resolve(host_, std::to_string(port_));
         
-        // Connect to endpoint
-        boost::asio::connect(socket_, endpoints);
+        // Connect to the first endpoint that accepts
+        boost::system::error_code ec = boost::asio::error::host_not_found;
+        for (const auto& entry : endpoints) {
+            if (prepareSocket(entry.endpoint(), ec)) {
+                socket_.connect(entry.endpoint(), ec);
+            }
+            if (!ec) {
+                break;
+            }
+        }
+        if (ec) {
+            throw boost::system::system_error(ec);
+        }
+        applySocketProfile(socket_, profile_);
         
-        // Start I/O thread
-        io_thread_ = std::thread([this]() {
-            log_debug("Network I/O thread started");
-            io_context_.run();
-            log_debug("Network I/O thread stopped");
-        });
+        startIo();
         
         // Start reading
         startAsyncRead();
@@ -49,39 +68,186 @@ bool NetworkTransport::open() {
         is_connected_ = true;
         log_info("Network transport connected successfully");
         return true;
-        
+    
     } catch (const boost::system::system_error& e) {
         log_error("Failed to connect to network: {}", e.what());
         return false;
     }
 }
 
+void NetworkTransport::openAsync(ConnectHandler handler, std::chrono::milliseconds timeout) {
+    if (is_connected_ || connecting_) {
+        log_warn("Network transport already open or connecting");
+        return;
+    }
+    
+    log_info("Connecting to network: {}:{} (timeout {} ms)", host_, port_, timeout.count());
+    
+    connecting_ = true;
+    connect_handler_ = std::move(handler);
+    
+    // Everything from here on happens on the I/O thread
+    boost::asio::post(io_context_, [this, timeout]() {
+        startConnect(timeout);
+    });
+    startIo();
+}
+
+void NetworkTransport::startConnect(std::chrono::milliseconds timeout) {
+    connect_timed_out_ = false;
+    auto attempt = std::make_shared<bool>(true);
+    connect_attempt_ = attempt;
+    
+    connect_timer_.expires_after(timeout);
+    connect_timer_.async_wait([this](const boost::system::error_code& ec) {
+        if (ec || !connecting_) {
+            return;
+        }
+        // Aborts whichever stage is outstanding; its handler reports the timeout
+        connect_timed_out_ = true;
+        resolver_.cancel();
+        boost::system::error_code ignored;
+        socket_.close(ignored);
+    });
+    
+    resolver_.async_resolve(host_, std::to_string(port_),
+        [this, attempt](const boost::system::error_code& ec, boost::asio::ip::tcp::resolver::results_type endpoints) {
+            if (!*attempt) {
+                return;  // Closed meanwhile; this may already be gone
+            }
+            if (ec) {
+                finishConnect(ec);
+                return;
+            }
+            if (endpoints.empty()) {
+                finishConnect(boost::asio::error::host_not_found);
+                return;
+            }
+            connectEndpoint(endpoints, endpoints.begin());
+        });
+}
+
+void NetworkTransport::connectEndpoint(Endpoints endpoints, Endpoints::const_iterator next) {
+    // One endpoint at a time rather than asio::async_connect, so the buffer
+    // sizes are set on each freshly opened socket before its handshake
+    auto after = std::next(next);
+    
+    boost::system::error_code ec;
+    if (!prepareSocket(next->endpoint(), ec)) {
+        if (after != endpoints.end()) {
+            connectEndpoint(endpoints, after);
+        } else {
+            finishConnect(ec);
+        }
+        return;
+    }
+    
+    socket_.async_connect(next->endpoint(), [this, endpoints, after](const boost::system::error_code& connect_ec) {
+        if (connect_ec && !connect_timed_out_ && after != endpoints.end()) {
+            connectEndpoint(endpoints, after);
+            return;
+        }
+        finishConnect(connect_ec);
+    });
+}
+
+bool NetworkTransport::prepareSocket(const boost::asio::ip::tcp::endpoint& endpoint, boost::system::error_code& ec) {
+    // Fresh socket per endpoint, like asio::connect, with buffers set before connect
+    boost::system::error_code ignored;
+    socket_.close(ignored);
+    socket_.open(endpoint.protocol(), ec);
+    if (ec) {
+        return false;
+    }
+    applySocketBuffers(socket_, profile_);
+    return true;
+}
+
+void NetworkTransport::finishConnect(boost::system::error_code ec) {
+    if (!connecting_) {
+        return;
+    }
+    
+    connect_timer_.cancel();
+    if (connect_timed_out_) {
+        ec = boost::asio::error::timed_out;
+    }
+    
+    if (!ec) {
+        applySocketProfile(socket_, profile_);
+        startAsyncRead();
+        is_connected_ = true;  // Before connecting_ clears, so observers never see neither
+        log_info("Network transport connected successfully");
+    } else {
+        log_error("Failed to connect to {}:{}: {}", host_, port_, ec.message());
+    }
+    connecting_ = false;
+    
+    ConnectHandler handler = std::move(connect_handler_);
+    connect_handler_ = nullptr;
+    if (handler) {
+        handler(ec);
+    }
+}
+
+void NetworkTransport::startIo() {
+    io_active_ = true;
+    if (!owned_io_context_ || io_thread_.joinable()) {
+        return;
+    }
+    // Reopening after close(): let the context run again
+    io_context_.restart();
+    io_thread_ = std::thread([this]() {
+        log_debug("Network I/O thread started");
+        io_context_.run();
+        log_debug("Network I/O thread stopped");
+    });
+}
+
 void NetworkTransport::close() {
-    if (!is_connected_) {
+    // A failed or pending openAsync() still has I/O to stop
+    if (!is_connected_ && !io_active_) {
         return;
     }
     
     log_info("Closing network transport");
     
     is_connected_ = false;
+    connecting_ = false;
     
-    try {
-        socket_.close();
-    } catch (const std::exception& e) {
-        log_error("Error closing socket: {}", e.what());
-    } catch (...) {
-        log_error("Unknown error closing socket");
-    }
-    
-    io_context_.stop();
+    auto close_socket = [this]() {
+        if (connect_attempt_) {
+            *connect_attempt_ = false;
+        }
+        connect_timer_.cancel();
+        resolver_.cancel();
+        
+        try {
+            socket_.close();
+        } catch (const std::exception& e) {
+            log_error("Error closing socket: {}", e.what());
+        } catch (...) {
+            log_error("Unknown error closing socket");
+        }
+    };
     
-    if (io_thread_.joinable()) {
-        log_debug("Joining network I/O thread");
-        io_thread_.join();
-        log_debug("Network I/O thread joined");
+    if (owned_io_context_) {
+        io_context_.stop();
+        
+        if (io_thread_.joinable()) {
+            log_debug("Joining network I/O thread");
+            io_thread_.join();
+            log_debug("Network I/O thread joined");
+        }
+        close_socket();
+    } else {
+        // The context keeps running for other transports: wait out our aborted handlers instead
+        runAndDrain(io_context_, close_socket);
     }
+    io_active_ = false;
     
     framer_.reset();
+    write_queue_.clear();
     
     log_info("Network transport closed");
 }
@@ -90,32 +256,93 @@ bool NetworkTransport::isOpen() const {
     return is_connected_;
 }
 
-void NetworkTransport::writeAsync(const std::vector<uint8_t>& data) {
+void NetworkTransport::writeAsync(const PacketCodec::EncodedPacket& packet) {
     if (!is_connected_) {
-        log_warn("Attempted write to disconnected network");
+        log_warn_limited("Attempted write to disconnected network");
         return;
     }
     
-    auto buffer = std::make_shared<std::vector<uint8_t>>(data);
+    bool start_write = false;
+    if (!write_queue_.push(packet, start_write)) {
+        log_warn_limited("Network write queue full, dropping {}-byte packet", packet.size);
+        return;
+    }
+    
+    // Writes are only ever issued from the I/O thread, one at a time
+    if (start_write) {
+        boost::asio::post(io_context_, [this]() {
+            startWrite();
+        });
+    }
+}
+
+void NetworkTransport::startWrite() {
+    auto batch = write_queue_.beginBatch();
+    if (batch.empty()) {
+        return;
+    }
     
+    // One gather write for everything queued; slot memory stays valid until completeBatch()
     boost::asio::async_write(
         socket_,
-        boost::asio::buffer(*buffer),
-        [buffer](const boost::system::error_code& ec, size_t bytes_written) {
-            if (ec) {
-                log_error("Network write error: {}", ec.message());
-            } else {
-                log_debug("Wrote {} bytes to network", bytes_written);
-            }
+        batch,
+        [this](const boost::system::error_code& ec, size_t bytes_written) {
+            handleWrite(ec, bytes_written);
         }
     );
 }
 
+void NetworkTransport::handleWrite(const boost::system::error_code& ec, size_t bytes_written) {
+    if (ec) {
+        if (ec != boost::asio::error::operation_aborted) {
+            log_error("Network write error: {}", ec.message());
+            notifyLinkLost("Network write error: " + ec.message());
+        }
+        write_queue_.clear();
+        return;
+    }
+    
+    log_debug("Wrote {} bytes to network", bytes_written);
+    if (metrics_) {
+        metrics_->bytes_out.add(bytes_written);
+    }
+    
+    if (write_queue_.completeBatch()) {
+        startWrite();
+    }
+}
+
 void NetworkTransport::setPacketReceivedCallback(PacketReceivedCallback callback) {
     std::lock_guard<std::mutex> lock(callback_mutex_);
     packet_callback_ = callback;
 }
 
+void NetworkTransport::setLinkLostCallback(LinkLostCallback callback) {
+    std::lock_guard<std::mutex> lock(callback_mutex_);
+    link_lost_callback_ = callback;
+}
+
+void NetworkTransport::setMetrics(LinkMetrics* metrics) {
+    metrics_ = metrics;
+    framer_.setMetrics(metrics);
+}
+
+void NetworkTransport::notifyLinkLost(const std::string& reason) {
+    // Read and write may both fail for the same drop; report it once
+    if (!is_connected_.exchange(false)) {
+        return;
+    }
+    
+    LinkLostCallback callback;
+    {
+        std::lock_guard<std::mutex> lock(callback_mutex_);
+        callback = link_lost_callback_;
+    }
+    if (callback) {
+        callback(reason);
+    }
+}
+
 std::string NetworkTransport::getConnectionInfo() const {
     return host_ + ":" + std::to_string(port_);
 }
@@ -133,12 +360,18 @@ void NetworkTransport::handleReadSome(const boost::system::error_code& ec, size_
     if (ec) {
         if (ec != boost::asio::error::operation_aborted) {
             log_error("Network read error: {}", ec.message());
+            notifyLinkLost(ec == boost::asio::error::eof
+                ? std::string("Connection closed by peer")
+                : "Network read error: " + ec.message());
         }
         return;
     }
     
     log_debug("Read {} bytes from network", bytes_read);
-
+    if (metrics_) {
+        metrics_->bytes_in.add(bytes_read);
+    }
+    
     framer_.feedData(temp_read_buffer_.data(), bytes_read);
     
     startAsyncRead();
@@ -3,46 +3,103 @@
 
 #include "core/transport_interface.hpp"
 #include "core/packet_framer.hpp"
+#include "core/write_queue.hpp"
+#include "core/socket_profile.hpp"
 #include <boost/asio.hpp>
 #include <thread>
 #include <mutex>
 #include <array>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
 
 /**
  * Network (TCP) transport - handles ONLY I/O
+ * 
+ * open() resolves and connects on the calling thread; openAsync() does the
+ * same on the I/O thread so the GUI never waits on DNS or a dead host.
  */
 class NetworkTransport :  public ITransport {
 public: 
-    NetworkTransport(const std::string& host, uint16_t port);
+    // Runs on the I/O thread; ec is clear on success, timed_out if the deadline passed
+    using ConnectHandler = std::function<void(const boost::system::error_code& ec)>;
+    
+    /**
+     * @param shared_io_context Run on this (already running) context instead of
+     *        an own I/O thread, e.g. one from an IoContextPool
+     */
+    NetworkTransport(const std::string& host, uint16_t port,
+                     const SocketProfile& profile = SocketProfile::osDefault(),
+                     boost::asio::io_context* shared_io_context = nullptr);
     ~NetworkTransport() override;
     
     bool open() override;
+    
+    /**
+     * Resolve and connect without blocking the caller
+     * @param handler Called exactly once with the outcome (not called if close() cancels the attempt)
+     * @param timeout Covers resolve and connect together
+     */
+    void openAsync(ConnectHandler handler, std::chrono::milliseconds timeout);
+    bool isConnecting() const { return connecting_; }
+    
     void close() override;
     bool isOpen() const override;
-    void writeAsync(const std::vector<uint8_t>& data) override;
+    void writeAsync(const PacketCodec::EncodedPacket& packet) override;
+    WriteQueue::Stats getWriteStats() const override { return write_queue_.getStats(); }
     void setPacketReceivedCallback(PacketReceivedCallback callback) override;
+    void setLinkLostCallback(LinkLostCallback callback) override;
+    void setMetrics(LinkMetrics* metrics) override;
     boost::asio::io_context& getIoContext() override { return io_context_; }
     std::string getConnectionInfo() const override;
     
 private:  
+    using Endpoints = boost::asio::ip::tcp::resolver::results_type;
+    
+    void startConnect(std::chrono::milliseconds timeout);
+    void connectEndpoint(Endpoints endpoints, Endpoints::const_iterator next);
+    void finishConnect(boost::system::error_code ec);
+    bool prepareSocket(const boost::asio::ip::tcp::endpoint& endpoint, boost::system::error_code& ec);
+    void startIo();
     void startAsyncRead();
     void handleReadSome(const boost::system::error_code& ec, size_t bytes_read);
+    void startWrite();
+    void handleWrite(const boost::system::error_code& ec, size_t bytes_written);
+    void notifyLinkLost(const std::string& reason);
     
     std::string host_;
     uint16_t port_;
+    SocketProfile profile_;
     
-    boost::asio::io_context io_context_;
+    std::unique_ptr<boost::asio::io_context> owned_io_context_;  // Null when shared
+    boost::asio::io_context& io_context_;
     boost::asio::ip::tcp::socket socket_;
+    boost::asio::ip::tcp::resolver resolver_;
+    boost::asio::steady_timer connect_timer_;
+    ConnectHandler connect_handler_;
+    bool connect_timed_out_;
+    
+    // Per attempt, cleared by close(). Resolves complete on Asio's resolver
+    // thread, possibly after close(); the flag outlives the transport.
+    std::shared_ptr<bool> connect_attempt_;
+    
     boost::asio::executor_work_guard<boost::asio::io_context::executor_type> work_guard_;
-    std::thread io_thread_;
+    std::thread io_thread_;     // Only with an owned context
+    bool io_active_;            // Between open()/openAsync() and close()
     
     std::array<uint8_t, 1024> temp_read_buffer_;
     PacketFramer framer_;
+    WriteQueue write_queue_;
     
     PacketReceivedCallback packet_callback_;
+    LinkLostCallback link_lost_callback_;
     std::mutex callback_mutex_;
     
-    bool is_connected_;
+    LinkMetrics* metrics_;      // Null until setMetrics()
+    
+    std::atomic<bool> is_connected_;    // Set on the I/O thread by openAsync()
+    std::atomic<bool> connecting_;
 };
 
 #endif // NETWORK_TRANSPORT_HPP
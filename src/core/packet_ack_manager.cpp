@@ -4,7 +4,14 @@
 
 PacketAckManager::PacketAckManager(boost::asio::io_context& io_context)
     : io_context_(io_context)
+    , tick_timer_(io_context)
+    , ticking_(false)
+    , slab_(MAX_PENDING)
+    , current_bucket_(0)
+    , pending_count_(0)
     , next_packet_id_(1) {
+    buckets_.fill(NONE);
+    expired_.reserve(MAX_PENDING);
 }
 
 PacketAckManager::~PacketAckManager() {
@@ -14,75 +21,202 @@ PacketAckManager::~PacketAckManager() {
 }
 
 uint32_t PacketAckManager::getNextPacketId() {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return next_packet_id_++;
+    return next_packet_id_.fetch_add(1, std::memory_order_relaxed);
 }
 
-void PacketAckManager::registerPacket(uint32_t packet_id, AckCallback callback, uint32_t timeout_ms) {
+size_t PacketAckManager::getPendingCount() const {
     std::lock_guard<std::mutex> lock(mutex_);
+    return pending_count_;
+}
+
+bool PacketAckManager::registerPacket(uint32_t packet_id, AckCallback callback, uint32_t timeout_ms) {
+    std::unique_lock<std::mutex> lock(mutex_);
     
-    PendingPacket pending;
-    pending.packet_id = packet_id;
-    pending.callback = callback;
-    pending.timer = std::make_shared<boost::asio::steady_timer>(io_context_);
+    uint32_t index = packet_id % MAX_PENDING;
+    PendingPacket& pending = slab_[index];
     
-    pending.timer->expires_after(std::chrono::milliseconds(timeout_ms));
-    pending.timer->async_wait([this, packet_id](const boost::system::error_code& ec) {
-        if (! ec) {
-            handleTimeout(packet_id);
+    if (pending.active) {
+        if (pending.packet_id != packet_id) {
+            // Slab slot still held by a packet MAX_PENDING ids older
+            lock.unlock();
+            log_warn_limited("Too many packets awaiting ACK, rejecting packet {}", packet_id);
+            return false;
         }
-    });
+        unlink(index);
+        pending_count_--;
+    }
+    
+    // +1 tick so a timeout can never fire early (the current tick is already partly elapsed)
+    size_t ticks = (static_cast<size_t>(timeout_ms) + TICK.count() - 1) / TICK.count() + 1;
+    
+    pending.packet_id = packet_id;
+    pending.active = true;
+    pending.rounds = static_cast<uint32_t>((ticks - 1) / WHEEL_SLOTS);
+    pending.callback = std::move(callback);
+    link(index, (current_bucket_ + ticks) % WHEEL_SLOTS);
+    pending_count_++;
+    
+    if (!ticking_) {
+        startTicking();
+    }
     
-    pending_packets_[packet_id] = std::move(pending);
     log_debug("Registered packet {} with {}ms timeout", packet_id, timeout_ms);
+    return true;
 }
 
 void PacketAckManager::handleAck(uint32_t packet_id) {
-    std::lock_guard<std::mutex> lock(mutex_);
+    std::unique_lock<std::mutex> lock(mutex_);
+    
+    uint32_t index = packet_id % MAX_PENDING;
+    PendingPacket& pending = slab_[index];
+    
+    if (!pending.active || pending.packet_id != packet_id) {
+        lock.unlock();
+        log_warn_limited("Received ACK for unknown packet {}", packet_id);
+        return;
+    }
+    
+    log_debug("Received ACK for packet {}", packet_id);
+    unlink(index);
+    pending.active = false;
+    pending_count_--;
+    auto callback = std::move(pending.callback);
+    pending.callback = nullptr;
+    
+    // Call callback outside lock to avoid deadlock
+    lock.unlock();
+    if (callback) {
+        callback(true, packet_id);
+    }
+}
+
+void PacketAckManager::cancelAll() {
+    std::vector<std::pair<AckCallback, uint32_t>> cancelled;
     
-    auto it = pending_packets_.find(packet_id);
-    if (it != pending_packets_.end()) {
-        log_debug("Received ACK for packet {}", packet_id);
-        it->second.timer->cancel();
-        auto callback = it->second.callback;
-        pending_packets_.erase(it);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
         
-        // Call callback outside lock to avoid deadlock
-        lock.~lock_guard();
+        log_info("Cancelling {} pending packets", pending_count_);
+        cancelled.reserve(pending_count_);
+        
+        for (auto& pending : slab_) {
+            if (pending.active) {
+                cancelled.emplace_back(std::move(pending.callback), pending.packet_id);
+                pending.callback = nullptr;
+                pending.active = false;
+                pending.prev = NONE;
+                pending.next = NONE;
+            }
+        }
+        buckets_.fill(NONE);
+        pending_count_ = 0;
+        
+        if (ticking_) {
+            tick_timer_.cancel();
+            ticking_ = false;
+        }
+    }
+    
+    // Call callbacks outside lock
+    for (auto& [callback, id] : cancelled) {
         if (callback) {
-            callback(true, packet_id);
+            callback(false, id);
         }
-    } else {
-        log_warn("Received ACK for unknown packet {}", packet_id);
     }
 }
 
-void PacketAckManager::handleTimeout(uint32_t packet_id) {
-    std::lock_guard<std::mutex> lock(mutex_);
+void PacketAckManager::startTicking() {
+    // Called with mutex_ held; the wheel only ticks while packets are pending
+    ticking_ = true;
+    next_tick_time_ = std::chrono::steady_clock::now() + TICK;
+    tick_timer_.expires_at(next_tick_time_);
+    tick_timer_.async_wait([this](const boost::system::error_code& ec) {
+        handleTick(ec);
+    });
+}
+
+void PacketAckManager::handleTick(const boost::system::error_code& ec) {
+    if (ec) {
+        return;
+    }
     
-    auto it = pending_packets_.find(packet_id);
-    if (it != pending_packets_.end()) {
-        log_warn("Timeout waiting for ACK of packet {}", packet_id);
-        auto callback = it->second.callback;
-        pending_packets_.erase(it);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        
+        // Catch up on every tick that elapsed if the I/O thread was held up
+        auto now = std::chrono::steady_clock::now();
+        while (next_tick_time_ <= now) {
+            current_bucket_ = (current_bucket_ + 1) % WHEEL_SLOTS;
+            expireBucket(current_bucket_);
+            next_tick_time_ += TICK;
+        }
         
-        // Call callback outside lock
-        lock.~lock_guard();
+        if (pending_count_ > 0) {
+            tick_timer_.expires_at(next_tick_time_);
+            tick_timer_.async_wait([this](const boost::system::error_code& ec) {
+                handleTick(ec);
+            });
+        } else {
+            ticking_ = false;
+        }
+    }
+    
+    // Call callbacks outside lock
+    for (auto& [callback, id] : expired_) {
+        log_warn_limited("Timeout waiting for ACK of packet {}", id);
         if (callback) {
-            callback(false, packet_id);
+            callback(false, id);
         }
     }
+    expired_.clear();
 }
 
-void PacketAckManager::cancelAll() {
-    std::lock_guard<std::mutex> lock(mutex_);
-
-    log_info("Cancelling {} pending packets", pending_packets_.size());
-    for (auto& [id, pending] : pending_packets_) {
-        pending.timer->cancel();
-        if (pending.callback) {
-            pending.callback(false, id);
+void PacketAckManager::expireBucket(size_t bucket) {
+    uint32_t index = buckets_[bucket];
+    
+    while (index != NONE) {
+        PendingPacket& pending = slab_[index];
+        uint32_t next = pending.next;
+        
+        if (pending.rounds > 0) {
+            pending.rounds--;
+        } else {
+            unlink(index);
+            pending.active = false;
+            pending_count_--;
+            expired_.emplace_back(std::move(pending.callback), pending.packet_id);
+            pending.callback = nullptr;
         }
+        
+        index = next;
+    }
+}
+
+void PacketAckManager::link(uint32_t index, size_t bucket) {
+    PendingPacket& pending = slab_[index];
+    pending.bucket = static_cast<uint32_t>(bucket);
+    pending.prev = NONE;
+    pending.next = buckets_[bucket];
+    
+    if (pending.next != NONE) {
+        slab_[pending.next].prev = index;
+    }
+    buckets_[bucket] = index;
+}
+
+void PacketAckManager::unlink(uint32_t index) {
+    PendingPacket& pending = slab_[index];
+    
+    if (pending.prev != NONE) {
+        slab_[pending.prev].next = pending.next;
+    } else {
+        buckets_[pending.bucket] = pending.next;
     }
-    pending_packets_.clear();
+    
+    if (pending.next != NONE) {
+        slab_[pending.next].prev = pending.prev;
+    }
+    
+    pending.prev = NONE;
+    pending.next = NONE;
 }
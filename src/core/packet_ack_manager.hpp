@@ -3,31 +3,45 @@
 
 #include <cstdint>
 #include <functional>
-#include <unordered_map>
+#include <vector>
+#include <array>
+#include <atomic>
 #include <mutex>
 #include <chrono>
-#include <memory>
+#include <utility>
 #include <boost/asio/steady_timer.hpp>
 #include <boost/asio/io_context.hpp>
 
 /**
  * Manages packet acknowledgements and timeouts
  * Thread-safe, works with both serial and network
+ * 
+ * Timeouts use a hashed timer wheel driven by a single asio timer that
+ * ticks every TICK while anything is pending. Pending packets live in a
+ * preallocated slab indexed by packet_id % MAX_PENDING, so registering,
+ * acking and expiring are O(1) and allocation-free.
  */
 class PacketAckManager {
 public:  
     using AckCallback = std::function<void(bool success, uint32_t packet_id)>;
     
+    static constexpr std::chrono::milliseconds TICK{5};
+    static constexpr size_t WHEEL_SLOTS = 512;    // One revolution = 2.56 s
+    static constexpr size_t MAX_PENDING = 4096;   // Slab size (in-flight packets)
+    
     explicit PacketAckManager(boost::asio::io_context& io_context);
     ~PacketAckManager();
     
     /**
      * Register a packet awaiting acknowledgement
+     * Re-registering a pending packet_id replaces its callback and timeout.
      * @param packet_id Unique packet identifier
      * @param callback Called when ack received or timeout
-     * @param timeout_ms Timeout in milliseconds
+     * @param timeout_ms Timeout in milliseconds (rounded up to TICK, never fires early)
+     * @return false if the packet's slab slot is held by a packet MAX_PENDING ids
+     *         older; the packet is not tracked and callback is never called
      */
-    void registerPacket(uint32_t packet_id, AckCallback callback, uint32_t timeout_ms);
+    bool registerPacket(uint32_t packet_id, AckCallback callback, uint32_t timeout_ms);
     
     /**
      * Handle received acknowledgement
@@ -45,19 +59,45 @@ public:
      */
     uint32_t getNextPacketId();
     
+    /**
+     * Number of packets awaiting acknowledgement
+     */
+    size_t getPendingCount() const;
+    
 private:
+    static constexpr uint32_t NONE = UINT32_MAX;
+    
     struct PendingPacket {
-        uint32_t packet_id;
+        uint32_t packet_id = 0;
+        bool active = false;
+        uint32_t bucket = 0;
+        uint32_t rounds = 0;    // Full wheel revolutions left before expiry
+        uint32_t prev = NONE;   // Intrusive bucket list links (slab indices)
+        uint32_t next = NONE;
         AckCallback callback;
-        std::shared_ptr<boost::asio::steady_timer> timer;
     };
     
-    void handleTimeout(uint32_t packet_id);
+    void startTicking();
+    void handleTick(const boost::system::error_code& ec);
+    void expireBucket(size_t bucket);
+    void link(uint32_t index, size_t bucket);
+    void unlink(uint32_t index);
     
     boost::asio::io_context& io_context_;
-    std::mutex mutex_;
-    std::unordered_map<uint32_t, PendingPacket> pending_packets_;
-    uint32_t next_packet_id_;
+    boost::asio::steady_timer tick_timer_;
+    bool ticking_;
+    std::chrono::steady_clock::time_point next_tick_time_;
+    
+    mutable std::mutex mutex_;
+    std::vector<PendingPacket> slab_;
+    std::array<uint32_t, WHEEL_SLOTS> buckets_;  // Head of each bucket's list
+    size_t current_bucket_;
+    size_t pending_count_;
+    
+    // Expired callbacks collected under the lock, invoked after it (I/O thread only)
+    std::vector<std::pair<AckCallback, uint32_t>> expired_;
+    
+    std::atomic<uint32_t> next_packet_id_;
 };
 
 #endif // PACKET_ACK_MANAGER_HPP
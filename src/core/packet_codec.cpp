@@ -1,4 +1,5 @@
 #include "core/packet_codec.hpp"
+#include <cstring>
 #include <stdexcept>
 
 std::vector<uint8_t> PacketCodec::encodeVarint(uint64_t value) {
@@ -14,30 +15,24 @@ std::vector<uint8_t> PacketCodec::encodeVarint(uint64_t value) {
     return result;
 }
 
-std::vector<uint8_t> PacketCodec::encode(const std::vector<uint8_t>& payload) {
-    if (payload.size() > MAX_PAYLOAD_SIZE) {
+void PacketCodec::encodeInto(const uint8_t* payload, size_t length, EncodedPacket& out) {
+    if (length > MAX_PAYLOAD_SIZE) {
         throw std::runtime_error("Payload exceeds max size of 62 bytes");
     }
     
-    std::vector<uint8_t> packet;
-    packet.reserve(MAX_PACKET_SIZE);
-    
-    // Sync byte
-    packet.push_back(SYNC_BYTE);
-    
-    // Varint length (will be 1 byte for values 0-62)
-    auto varint = encodeVarint(payload.size());
-    packet.insert(packet.end(), varint.begin(), varint.end());
-    
-    // Payload
-    packet.insert(packet.end(), payload.begin(), payload.end());
-    
-    // Verify total size
-    if (packet.size() > MAX_PACKET_SIZE) {
-        throw std::runtime_error("Total packet exceeds 64 bytes");
+    out.bytes[0] = SYNC_BYTE;
+    out.bytes[1] = encodeLength(length);
+    if (length > 0) {
+        std::memcpy(out.bytes.data() + 2, payload, length);
     }
+    out.size = length + 2;
+}
+
+std::vector<uint8_t> PacketCodec::encode(const std::vector<uint8_t>& payload) {
+    EncodedPacket packet;
+    encodeInto(payload.data(), payload.size(), packet);
     
-    return packet;
+    return std::vector<uint8_t>(packet.data(), packet.data() + packet.size);
 }
 
 bool PacketCodec::decodeVarint(const std::vector<uint8_t>& buffer, 
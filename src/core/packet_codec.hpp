@@ -2,7 +2,9 @@
 #define PACKET_CODEC_HPP
 
 #include <vector>
+#include <array>
 #include <cstdint>
+#include <cstddef>
 
 /**
  * Packet codec for op-controls protocol:
@@ -19,6 +21,33 @@ public:
     static constexpr size_t MAX_PACKET_SIZE = 64;  // Total packet size
     static constexpr size_t MAX_PAYLOAD_SIZE = 62;  // 64 - 1 (sync) - 1 (length)
     
+    static_assert(MAX_PAYLOAD_SIZE < 0x80, "Payload length must fit in a single varint byte");
+    
+    /**
+     * A complete encoded packet in a fixed-size buffer (no heap storage)
+     */
+    struct EncodedPacket {
+        std::array<uint8_t, MAX_PACKET_SIZE> bytes;
+        size_t size = 0;
+        
+        const uint8_t* data() const { return bytes.data(); }
+    };
+    
+    /**
+     * Single-byte varint specialisation for payload lengths ≤ MAX_PAYLOAD_SIZE
+     */
+    static constexpr uint8_t encodeLength(size_t payload_length) {
+        return static_cast<uint8_t>(payload_length & 0x7F);
+    }
+    
+    /**
+     * Encode payload directly into a fixed packet buffer, no allocation
+     * Writes: [0xAA] [1-byte length] [payload]
+     * 
+     * @throws std::runtime_error if payload exceeds MAX_PAYLOAD_SIZE
+     */
+    static void encodeInto(const uint8_t* payload, size_t length, EncodedPacket& out);
+    
     /**
      * Encode payload with sync byte and varint length prefix
      * Returns: [0xAA] [varint length] [payload]
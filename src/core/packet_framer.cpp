@@ -1,98 +1,115 @@
 #include "core/packet_framer.hpp"
 #include "util/logging.hpp"
+#include <algorithm>
+#include <cstring>
 
 PacketFramer::PacketFramer(PacketCallback callback)
     : state_(State::SEARCHING_SYNC)
+    , ring_index_(0)
     , expected_length_(0)
+    , payload_length_(0)
     , packet_callback_(callback)
-    , dropped_sync_bytes_(0)
-    , packets_received_(0) {
-    payload_buffer_.reserve(PacketCodec::MAX_PAYLOAD_SIZE);
-    length_buffer_.reserve(2);  // Max 2 bytes for varint (though typically 1)
+    , metrics_(nullptr) {
 }
 
 void PacketFramer::feedData(const uint8_t* data, size_t length) {
-    for (size_t i = 0; i < length; ++i) {
-        uint8_t byte = data[i];
-        
+    const uint8_t* cursor = data;
+    const uint8_t* const end = data + length;
+    
+    while (cursor < end) {
         switch (state_) {
-            case State::SEARCHING_SYNC:
-                if (byte == PacketCodec::SYNC_BYTE) {
-                    log_debug("Found sync byte");
-                    length_buffer_.clear();
-                    state_ = State::READING_LENGTH;
-                } else {
-                    dropped_sync_bytes_++;
+            case State::SEARCHING_SYNC: {
+                // memchr is SSE2/AVX2 vectorised in glibc and the MSVC CRT,
+                // so noise between packets is skipped in bulk
+                const auto* sync = static_cast<const uint8_t*>(
+                    std::memchr(cursor, PacketCodec::SYNC_BYTE, static_cast<size_t>(end - cursor)));
+                
+                if (sync == nullptr) {
+                    dropBytes(static_cast<size_t>(end - cursor));
+                    return;
                 }
+                
+                if (sync != cursor) {
+                    dropBytes(static_cast<size_t>(sync - cursor));
+                }
+                cursor = sync + 1;
+                state_ = State::READING_LENGTH;
                 break;
+            }
                 
-            case State::READING_LENGTH:
-                // Accumulate varint bytes
-                length_buffer_.push_back(byte);
+            case State::READING_LENGTH: {
+                // Payloads ≤62 bytes always encode as a single varint byte, so any
+                // byte above MAX_PAYLOAD_SIZE (including a set continuation bit) is corrupt
+                uint8_t length_byte = *cursor;
                 
-                // Try to decode varint
-                uint64_t payload_length;
-                size_t varint_bytes;
-                if (codec_.decodeVarint(length_buffer_, payload_length, varint_bytes)) {
-                    // Varint complete!
-                    expected_length_ = payload_length;
-                    
-                    log_debug("Decoded length: {} bytes (varint used {} byte{})", 
-                              expected_length_, varint_bytes, varint_bytes > 1 ? "s" : "");
-                    
-                    if (expected_length_ == 0) {
-                        // Zero-length packet (valid edge case)
-                        log_debug("Received zero-length packet");
-                        if (packet_callback_) {
-                            std::vector<uint8_t> empty;
-                            packet_callback_(empty);
-                        }
-                        packets_received_++;
-                        state_ = State::SEARCHING_SYNC;
-                    } else {
-                        // Start reading payload
-                        payload_buffer_.clear();
-                        payload_buffer_.reserve(expected_length_);
-                        state_ = State::READING_PAYLOAD;
+                if (length_byte > PacketCodec::MAX_PAYLOAD_SIZE) {
+                    // Drop the sync byte but leave this one in the stream,
+                    // it may be the start of the real packet
+                    dropBytes(1);
+                    framing_errors_.add();
+                    if (metrics_) {
+                        metrics_->framing_errors.add();
                     }
-                } else if (length_buffer_.size() >= 2) {
-                    // Varint should never exceed 1 byte for lengths ≤62
-                    // If we have 2+ bytes and still no valid varint, it's corrupt
-                    log_warn("Invalid varint length (>1 byte for length ≤62), resetting");
-                    length_buffer_.clear();
                     state_ = State::SEARCHING_SYNC;
-                    dropped_sync_bytes_++;
+                    break;
+                }
+                
+                ++cursor;
+                expected_length_ = length_byte;
+                payload_length_ = 0;
+                
+                if (expected_length_ == 0) {
+                    // Zero-length packet (valid edge case)
+                    deliverPacket();
+                } else {
+                    state_ = State::READING_PAYLOAD;
                 }
                 break;
+            }
                 
-            case State::READING_PAYLOAD:
-                payload_buffer_.push_back(byte);
+            case State::READING_PAYLOAD: {
+                // Copy as much of the payload as this chunk holds in one go
+                size_t remaining = expected_length_ - payload_length_;
+                size_t run = std::min(remaining, static_cast<size_t>(end - cursor));
                 
-                // Check if packet complete
-                if (payload_buffer_.size() >= expected_length_) {
-                    log_debug("Received complete packet ({} bytes payload)", payload_buffer_.size());
-                    
-                    // Deliver packet
-                    if (packet_callback_) {
-                        packet_callback_(payload_buffer_);
-                    }
-                    
-                    packets_received_++;
-                    
-                    // Reset for next packet
-                    payload_buffer_.clear();
-                    state_ = State::SEARCHING_SYNC;
+                std::memcpy(ring_[ring_index_].bytes.data() + payload_length_, cursor, run);
+                payload_length_ += run;
+                cursor += run;
+                
+                if (payload_length_ == expected_length_) {
+                    deliverPacket();
                 }
                 break;
+            }
         }
     }
 }
 
+void PacketFramer::deliverPacket() {
+    const Slot& slot = ring_[ring_index_];
+    
+    // Advance first: feedData() re-entered from the callback must not
+    // assemble into the slot the callback is still reading
+    ring_index_ = (ring_index_ + 1) % RING_SLOTS;
+    packets_received_.add();
+    state_ = State::SEARCHING_SYNC;
+    
+    if (packet_callback_) {
+        packet_callback_(PacketView(slot.bytes.data(), payload_length_));
+    }
+}
+
+void PacketFramer::dropBytes(size_t count) {
+    dropped_sync_bytes_.add(count);
+    if (metrics_) {
+        metrics_->dropped_bytes.add(count);
+    }
+}
+
 void PacketFramer::reset() {
     state_ = State::SEARCHING_SYNC;
-    length_buffer_.clear();
-    payload_buffer_.clear();
+    payload_length_ = 0;
     expected_length_ = 0;
-    log_debug("PacketFramer reset (dropped: {}, received: {})", 
-              dropped_sync_bytes_, packets_received_);
+    log_debug("PacketFramer reset (dropped: {}, received: {}, framing errors: {})", 
+              getDroppedSyncBytes(), getPacketsReceived(), getFramingErrors());
 }
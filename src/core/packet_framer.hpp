@@ -2,7 +2,9 @@
 #define PACKET_FRAMER_HPP
 
 #include "core/packet_codec.hpp"
-#include <vector>
+#include "core/packet_view.hpp"
+#include "core/metrics.hpp"
+#include <array>
 #include <functional>
 #include <cstdint>
 
@@ -14,14 +16,27 @@
  * Max payload: 62 bytes (64 - sync - length)
  * 
  * State machine:
- * 1. Search for 0xAA sync byte
+ * 1. Search for 0xAA sync byte (bulk memchr scan over the whole chunk)
  * 2. Read varint length (guaranteed 1 byte for payloads ≤62)
- * 3. Read payload of specified length
+ * 3. Read payload of specified length (bulk copy of the available run)
  * 4. Deliver complete packet via callback
+ * 
+ * Only the state carried across chunk boundaries is per-byte; bytes within
+ * a chunk are consumed in runs.
+ * 
+ * Payloads are assembled in place in a preallocated ring of 64-byte slots
+ * and delivered as a PacketView into that ring, so framing performs no
+ * heap allocation. As with ITransport::PacketReceivedCallback, the view is
+ * only valid for the duration of the callback.
+ * 
+ * The statistics are relaxed atomics, so any thread may read them while
+ * the I/O thread frames.
  */
 class PacketFramer {
 public:
-    using PacketCallback = std::function<void(const std::vector<uint8_t>&)>;
+    using PacketCallback = std::function<void(PacketView)>;
+    
+    static constexpr size_t RING_SLOTS = 8;
     
     explicit PacketFramer(PacketCallback callback);
     
@@ -36,13 +51,23 @@ public:
      */
     void reset();
     
+    /**
+     * Also count framing errors and dropped bytes into a link's metrics
+     * (null to stop). Set before data is fed.
+     */
+    void setMetrics(LinkMetrics* metrics) { metrics_ = metrics; }
+    
     /**
      * Get statistics
      */
-    size_t getDroppedSyncBytes() const { return dropped_sync_bytes_; }
-    size_t getPacketsReceived() const { return packets_received_; }
+    size_t getDroppedSyncBytes() const { return dropped_sync_bytes_.get(); }
+    size_t getPacketsReceived() const { return packets_received_.get(); }
+    size_t getFramingErrors() const { return framing_errors_.get(); }
     
 private:
+    void deliverPacket();
+    void dropBytes(size_t count);
+    
     enum class State {
         SEARCHING_SYNC,   // Looking for 0xAA
         READING_LENGTH,   // Accumulating varint length bytes
@@ -50,17 +75,23 @@ private:
     };
     
     State state_;
-    PacketCodec codec_;
     
-    std::vector<uint8_t> length_buffer_;  // Accumulate varint bytes
-    uint64_t expected_length_;
-    std::vector<uint8_t> payload_buffer_;
+    struct alignas(PacketCodec::MAX_PACKET_SIZE) Slot {
+        std::array<uint8_t, PacketCodec::MAX_PACKET_SIZE> bytes;
+    };
+    
+    std::array<Slot, RING_SLOTS> ring_;
+    size_t ring_index_;       // Slot the current payload is assembled in
+    size_t expected_length_;
+    size_t payload_length_;   // Bytes of the current payload received so far
     
     PacketCallback packet_callback_;
+    LinkMetrics* metrics_;
     
     // Statistics
-    size_t dropped_sync_bytes_;
-    size_t packets_received_;
+    Counter dropped_sync_bytes_;
+    Counter packets_received_;
+    Counter framing_errors_;
 };
 
 #endif // PACKET_FRAMER_HPP
@@ -0,0 +1,33 @@
+#ifndef PACKET_VIEW_HPP
+#define PACKET_VIEW_HPP
+
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * Non-owning view of a received packet payload (pointer + length)
+ * 
+ * Points into the transport's receive memory (e.g. the PacketFramer ring),
+ * so it is only valid for the duration of the packet callback. Consumers
+ * that need the bytes beyond it must copy them.
+ */
+class PacketView {
+public:
+    constexpr PacketView() = default;
+    constexpr PacketView(const uint8_t* data, size_t size) : data_(data), size_(size) {}
+    
+    constexpr const uint8_t* data() const { return data_; }
+    constexpr size_t size() const { return size_; }
+    constexpr bool empty() const { return size_ == 0; }
+    
+    constexpr const uint8_t* begin() const { return data_; }
+    constexpr const uint8_t* end() const { return data_ + size_; }
+    
+    constexpr uint8_t operator[](size_t index) const { return data_[index]; }
+    
+private:
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+#endif // PACKET_VIEW_HPP
@@ -0,0 +1,89 @@
+#ifndef RECORDING_FORMAT_HPP
+#define RECORDING_FORMAT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+/**
+ * On-disk layout of telemetry recordings (.oprec)
+ * 
+ *   [FileHeader, padded to FILE_HEADER_SIZE]
+ *   [chunk 0: ChunkHeader | records ... ]   CHUNK_SIZE bytes
+ *   [chunk 1: ChunkHeader | records ... ]
+ *   ...
+ *   [last chunk, truncated to its used bytes]
+ *   [ChunkIndexEntry x chunk_count]         written on clean stop
+ * 
+ * Records are packed back to back: RecordHeader then `length` payload
+ * bytes. A record never spans chunks; a zero direction byte (never
+ * written) marks the end of the records in a chunk. Each chunk header
+ * carries its own time range and record count, so the chunks double as
+ * a periodic seek index even if the footer was never written (crash).
+ * 
+ * Timestamps are steady-clock nanoseconds since the recording started.
+ * All integers are little-endian.
+ */
+namespace RecordingFormat {
+
+constexpr char MAGIC[8] = {'O', 'P', 'G', 'C', 'R', 'E', 'C', '1'};
+constexpr uint32_t VERSION = 1;
+constexpr uint32_t CHUNK_MAGIC = 0x4B4E4843;  // "CHNK"
+
+constexpr size_t FILE_HEADER_SIZE = 4096;     // Keeps chunks page-aligned for mapping
+constexpr size_t CHUNK_SIZE = 1024 * 1024;
+
+enum class Direction : uint8_t {
+    End = 0,        // No more records in this chunk
+    Received = 1,   // Packet payload delivered by the framer
+    Sent = 2        // Payload handed to the transport by sendMessage
+};
+
+struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t chunk_size;
+    uint64_t start_unix_ns;     // Wall clock at start, for display only
+    uint64_t index_offset;      // 0 until the recording is closed cleanly
+    uint32_t chunk_count;
+    uint32_t reserved;
+};
+
+struct ChunkHeader {
+    uint32_t magic;
+    uint32_t chunk_index;
+    uint64_t first_timestamp_ns;
+    uint64_t last_timestamp_ns;
+    uint32_t record_count;
+    uint32_t used_bytes;        // Including this header
+};
+
+#pragma pack(push, 1)
+struct RecordHeader {
+    uint64_t timestamp_ns;
+    Direction direction;
+    uint8_t length;
+};
+#pragma pack(pop)
+
+struct ChunkIndexEntry {
+    uint64_t offset;            // File offset of the ChunkHeader
+    uint64_t first_timestamp_ns;
+    uint64_t last_timestamp_ns;
+    uint32_t record_count;
+    uint32_t used_bytes;
+};
+
+static_assert(sizeof(FileHeader) == 40, "FileHeader layout changed");
+static_assert(sizeof(ChunkHeader) == 32, "ChunkHeader layout changed");
+static_assert(sizeof(RecordHeader) == 10, "RecordHeader layout changed");
+static_assert(sizeof(ChunkIndexEntry) == 32, "ChunkIndexEntry layout changed");
+static_assert(std::is_trivially_copyable_v<RecordHeader>, "Records are memcpy'd");
+
+constexpr uint64_t chunkOffset(uint32_t chunk_index) {
+    return FILE_HEADER_SIZE + static_cast<uint64_t>(chunk_index) * CHUNK_SIZE;
+}
+
+} // namespace RecordingFormat
+
+#endif // RECORDING_FORMAT_HPP
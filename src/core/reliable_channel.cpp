@@ -0,0 +1,246 @@
+#include "core/reliable_channel.hpp"
+#include "util/logging.hpp"
+#include <algorithm>
+#include <cmath>
+
+ReliableChannel::ReliableChannel(PacketAckManager& ack_manager, SendFunction send)
+    : ReliableChannel(ack_manager, std::move(send), Config{}) {
+}
+
+ReliableChannel::ReliableChannel(PacketAckManager& ack_manager, SendFunction send, Config config)
+    : ack_manager_(ack_manager)
+    , send_(std::move(send))
+    , config_(config)
+    , in_flight_(0)
+    , have_rtt_sample_(false)
+    , srtt_ms_(0.0)
+    , rttvar_ms_(0.0)
+    , rto_ms_(config.initial_rto_ms)
+    , delivered_(0)
+    , failed_(0)
+    , retransmissions_(0) {
+    // Every in-flight packet needs its own slot in the ack manager's slab
+    config_.window_size = std::clamp<size_t>(config_.window_size, 1, PacketAckManager::MAX_PENDING / 2);
+    window_.resize(config_.window_size);
+    
+    log_debug("ReliableChannel created (window {}, max retries {})", 
+              config_.window_size, config_.max_retries);
+}
+
+ReliableChannel::~ReliableChannel() {
+    cancelAll();
+}
+
+void ReliableChannel::send(uint32_t packet_id, const PacketCodec::EncodedPacket& packet,
+                           DeliveryCallback callback, uint32_t deadline_ms) {
+    std::vector<Transmission> transmissions;
+    
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        
+        Entry entry;
+        entry.packet_id = packet_id;
+        entry.packet = packet;
+        entry.callback = std::move(callback);
+        entry.deadline = Clock::now() + std::chrono::milliseconds(deadline_ms);
+        entry.active = true;
+        
+        waiting_.push_back(std::move(entry));
+        fillWindow(transmissions);
+    }
+    
+    transmitAll(transmissions);
+}
+
+void ReliableChannel::cancelAll() {
+    std::vector<DeliveryCallback> cancelled;
+    
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        
+        for (auto& entry : window_) {
+            if (entry.active) {
+                cancelled.push_back(std::move(entry.callback));
+                entry = Entry{};
+            }
+        }
+        for (auto& entry : waiting_) {
+            cancelled.push_back(std::move(entry.callback));
+        }
+        waiting_.clear();
+        in_flight_ = 0;
+        failed_ += cancelled.size();
+    }
+    
+    if (!cancelled.empty()) {
+        log_info("Cancelled {} reliable packets", cancelled.size());
+    }
+    
+    // Call callbacks outside lock
+    for (auto& callback : cancelled) {
+        if (callback) {
+            callback(false);
+        }
+    }
+}
+
+ReliableChannel::Stats ReliableChannel::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    Stats stats;
+    stats.srtt_ms = srtt_ms_;
+    stats.rttvar_ms = rttvar_ms_;
+    stats.rto_ms = rto_ms_;
+    stats.in_flight = in_flight_;
+    stats.queued = waiting_.size();
+    stats.delivered = delivered_;
+    stats.failed = failed_;
+    stats.retransmissions = retransmissions_;
+    return stats;
+}
+
+void ReliableChannel::handleAckResult(uint32_t packet_id, bool success) {
+    DeliveryCallback done;
+    bool delivered = false;
+    bool retransmit = false;
+    std::vector<Transmission> transmissions;
+    
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        
+        auto it = std::find_if(window_.begin(), window_.end(), [packet_id](const Entry& entry) {
+            return entry.active && entry.packet_id == packet_id;
+        });
+        if (it == window_.end()) {
+            return;  // Cancelled, or a late ack for a packet already resolved
+        }
+        
+        Entry& entry = *it;
+        auto now = Clock::now();
+        
+        if (success) {
+            // Karn's rule: an ack for a retransmitted packet is ambiguous, don't sample it
+            if (entry.attempts == 1) {
+                updateRto(std::chrono::duration<double, std::milli>(now - entry.last_sent).count());
+            }
+            delivered = true;
+            delivered_++;
+        } else if (entry.attempts <= config_.max_retries && now < entry.deadline) {
+            log_debug("Retransmitting packet {} (attempt {})", packet_id, entry.attempts + 1);
+            retransmissions_++;
+            transmissions.push_back(prepareTransmit(entry));
+            retransmit = true;
+        } else {
+            log_warn_limited("Giving up on packet {} after {} attempts", packet_id, entry.attempts);
+            failed_++;
+        }
+        
+        if (!retransmit) {
+            done = std::move(entry.callback);
+            entry = Entry{};
+            in_flight_--;
+            fillWindow(transmissions);
+        }
+    }
+    
+    // Register and send outside lock
+    transmitAll(transmissions);
+    
+    // Call callback outside lock
+    if (done) {
+        done(delivered);
+    }
+}
+
+ReliableChannel::Transmission ReliableChannel::prepareTransmit(Entry& entry) {
+    // Called with mutex_ held. Each retransmission doubles the packet's RTO (Karn)
+    auto now = Clock::now();
+    uint32_t rto_ms = entry.attempts == 0
+        ? static_cast<uint32_t>(std::lround(rto_ms_))
+        : std::min(entry.rto_ms * 2, config_.max_rto_ms);
+    
+    // Never wait past the delivery deadline
+    auto remaining_ms = std::chrono::duration_cast<std::chrono::milliseconds>(entry.deadline - now).count();
+    rto_ms = static_cast<uint32_t>(std::clamp<long long>(remaining_ms, 1, rto_ms));
+    
+    entry.attempts++;
+    entry.rto_ms = rto_ms;
+    entry.last_sent = now;
+    
+    return Transmission{entry.packet_id, rto_ms, entry.packet};
+}
+
+void ReliableChannel::transmitAll(std::vector<Transmission>& transmissions) {
+    // Called without mutex_ held. Rejected packets free their window slot,
+    // which may append more transmissions, so iterate by index
+    for (size_t i = 0; i < transmissions.size(); ++i) {
+        bool registered = ack_manager_.registerPacket(transmissions[i].packet_id, [this](bool success, uint32_t id) {
+            handleAckResult(id, success);
+        }, transmissions[i].rto_ms);
+        
+        if (registered) {
+            send_(transmissions[i].packet);
+        } else {
+            failRejected(transmissions[i].packet_id, transmissions);
+        }
+    }
+}
+
+void ReliableChannel::failRejected(uint32_t packet_id, std::vector<Transmission>& transmissions) {
+    // An untrackable packet is never sent, and retrying would only hit the same slot
+    DeliveryCallback done;
+    
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        
+        auto it = std::find_if(window_.begin(), window_.end(), [packet_id](const Entry& entry) {
+            return entry.active && entry.packet_id == packet_id;
+        });
+        if (it == window_.end()) {
+            return;  // Cancelled meanwhile
+        }
+        
+        log_warn_limited("Packet {} rejected by the ack manager, failing it", packet_id);
+        failed_++;
+        done = std::move(it->callback);
+        *it = Entry{};
+        in_flight_--;
+        fillWindow(transmissions);
+    }
+    
+    if (done) {
+        done(false);
+    }
+}
+
+void ReliableChannel::fillWindow(std::vector<Transmission>& transmissions) {
+    // Called with mutex_ held
+    for (auto& slot : window_) {
+        if (waiting_.empty()) {
+            return;
+        }
+        if (!slot.active) {
+            slot = std::move(waiting_.front());
+            waiting_.pop_front();
+            in_flight_++;
+            transmissions.push_back(prepareTransmit(slot));
+        }
+    }
+}
+
+void ReliableChannel::updateRto(double rtt_ms) {
+    // RFC 6298: alpha = 1/8, beta = 1/4, K = 4
+    if (!have_rtt_sample_) {
+        srtt_ms_ = rtt_ms;
+        rttvar_ms_ = rtt_ms / 2.0;
+        have_rtt_sample_ = true;
+    } else {
+        rttvar_ms_ = 0.75 * rttvar_ms_ + 0.25 * std::abs(srtt_ms_ - rtt_ms);
+        srtt_ms_ = 0.875 * srtt_ms_ + 0.125 * rtt_ms;
+    }
+    
+    double tick_ms = static_cast<double>(PacketAckManager::TICK.count());
+    rto_ms_ = srtt_ms_ + std::max(tick_ms, 4.0 * rttvar_ms_);
+    rto_ms_ = std::clamp(rto_ms_, static_cast<double>(config_.min_rto_ms), 
+                         static_cast<double>(config_.max_rto_ms));
+}
@@ -0,0 +1,124 @@
+#ifndef RELIABLE_CHANNEL_HPP
+#define RELIABLE_CHANNEL_HPP
+
+#include "core/packet_codec.hpp"
+#include "core/packet_ack_manager.hpp"
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <chrono>
+
+/**
+ * Selective-repeat reliable delivery on top of PacketAckManager
+ * 
+ * Up to window_size packets are in flight at once, each acknowledged and
+ * retransmitted individually; further packets wait in order for a free
+ * window slot. The retransmission timeout adapts to measured ack RTT
+ * (Jacobson/Karels, with Karn's rule: retransmitted packets give no RTT
+ * sample and back the RTO off exponentially).
+ * 
+ * Thread-safe: send() from any thread, ack results arrive on the I/O thread.
+ */
+class ReliableChannel {
+public:
+    using DeliveryCallback = std::function<void(bool success)>;
+    using SendFunction = std::function<void(const PacketCodec::EncodedPacket&)>;
+    
+    struct Config {
+        size_t window_size = 8;
+        uint32_t max_retries = 5;
+        uint32_t initial_rto_ms = 250;
+        uint32_t min_rto_ms = 20;
+        uint32_t max_rto_ms = 2000;
+    };
+    
+    struct Stats {
+        double srtt_ms = 0.0;
+        double rttvar_ms = 0.0;
+        double rto_ms = 0.0;
+        size_t in_flight = 0;
+        size_t queued = 0;
+        uint64_t delivered = 0;
+        uint64_t failed = 0;
+        uint64_t retransmissions = 0;
+    };
+    
+    /**
+     * @param ack_manager Tracks acks/timeouts for every transmission
+     * @param send Writes an encoded packet to the transport
+     */
+    ReliableChannel(PacketAckManager& ack_manager, SendFunction send);
+    ReliableChannel(PacketAckManager& ack_manager, SendFunction send, Config config);
+    ~ReliableChannel();
+    
+    ReliableChannel(const ReliableChannel&) = delete;
+    ReliableChannel& operator=(const ReliableChannel&) = delete;
+    
+    /**
+     * Send a packet reliably
+     * @param packet_id ID the firmware acknowledges (must be carried in the payload)
+     * @param packet Encoded packet, retransmitted verbatim
+     * @param callback Called once: true when acked, false when retries or the deadline run out
+     * @param deadline_ms Overall delivery deadline, including queueing and retries
+     */
+    void send(uint32_t packet_id, const PacketCodec::EncodedPacket& packet,
+              DeliveryCallback callback, uint32_t deadline_ms);
+    
+    /**
+     * Fail everything queued or in flight (e.g., on disconnect)
+     */
+    void cancelAll();
+    
+    Stats getStats() const;
+    
+private:
+    using Clock = std::chrono::steady_clock;
+    
+    struct Entry {
+        uint32_t packet_id = 0;
+        PacketCodec::EncodedPacket packet;
+        DeliveryCallback callback;
+        Clock::time_point deadline;
+        Clock::time_point last_sent;
+        uint32_t attempts = 0;
+        uint32_t rto_ms = 0;     // RTO used for the latest transmission
+        bool active = false;
+    };
+    
+    // A transmission decided under mutex_, carried out after releasing it
+    struct Transmission {
+        uint32_t packet_id = 0;
+        uint32_t rto_ms = 0;
+        PacketCodec::EncodedPacket packet;
+    };
+    
+    void handleAckResult(uint32_t packet_id, bool success);
+    Transmission prepareTransmit(Entry& entry);
+    void transmitAll(std::vector<Transmission>& transmissions);
+    void failRejected(uint32_t packet_id, std::vector<Transmission>& transmissions);
+    void fillWindow(std::vector<Transmission>& transmissions);
+    void updateRto(double rtt_ms);
+    
+    PacketAckManager& ack_manager_;
+    SendFunction send_;
+    Config config_;
+    
+    mutable std::mutex mutex_;
+    std::vector<Entry> window_;      // window_size slots, preallocated
+    std::deque<Entry> waiting_;      // Packets beyond the window, in send order
+    size_t in_flight_;
+    
+    // Jacobson/Karels estimator
+    bool have_rtt_sample_;
+    double srtt_ms_;
+    double rttvar_ms_;
+    double rto_ms_;
+    
+    uint64_t delivered_;
+    uint64_t failed_;
+    uint64_t retransmissions_;
+};
+
+#endif // RELIABLE_CHANNEL_HPP
@@ -0,0 +1,289 @@
+#include "core/replay_transport.hpp"
+#include "util/logging.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+
+namespace bip = boost::interprocess;
+using namespace RecordingFormat;
+
+namespace {
+    // Records handed to the framer per handler at max speed
+    constexpr size_t MAX_BATCH_RECORDS = 256;
+}
+
+ReplayTransport::ReplayTransport(const std::string& path, double speed)
+    : path_(path)
+    , speed_(speed)
+    , next_record_(0)
+    , timer_(io_context_)
+    , work_guard_(boost::asio::make_work_guard(io_context_))
+    , framer_([this](PacketView packet) {
+          std::lock_guard<std::mutex> lock(callback_mutex_);
+          if (packet_callback_) {
+              packet_callback_(packet);
+          }
+      })
+    , replayed_(0)
+    , written_(0)
+    , finish_ns_(-1)
+    , is_open_(false)
+    , started_(false) {
+    batch_.reserve(MAX_BATCH_RECORDS * PacketCodec::MAX_PACKET_SIZE);
+}
+
+ReplayTransport::~ReplayTransport() {
+    close();
+}
+
+bool ReplayTransport::open() {
+    if (is_open_) {
+        log_warn("Replay transport already open");
+        return true;
+    }
+    
+    try {
+        log_info("Opening replay: {} at {}", path_,
+                 speed_ > 0.0 ? std::to_string(speed_) + "x" : std::string("max speed"));
+        
+        if (!loadRecords()) {
+            return false;
+        }
+        
+        log_info("Replay loaded {} received packets", records_.size());
+        
+        next_record_ = 0;
+        replayed_ = 0;
+        finish_ns_ = -1;
+        started_ = false;
+        start_time_ = std::chrono::steady_clock::now();
+        
+        io_thread_ = std::thread([this]() {
+            log_debug("Replay I/O thread started");
+            io_context_.run();
+            log_debug("Replay I/O thread stopped");
+        });
+        
+        // Playback starts once the backend has attached its callback
+        is_open_ = true;
+        return true;
+    
+    } catch (const std::exception& e) {
+        log_error("Failed to open replay {}: {}", path_, e.what());
+        return false;
+    }
+}
+
+bool ReplayTransport::loadRecords() {
+    if (!std::filesystem::exists(path_)) {
+        log_error("Replay file not found: {}", path_);
+        return false;
+    }
+    
+    file_ = bip::file_mapping(path_.c_str(), bip::read_only);
+    region_ = bip::mapped_region(file_, bip::read_only);
+    
+    const uint8_t* base = static_cast<const uint8_t*>(region_.get_address());
+    size_t size = region_.get_size();
+    
+    FileHeader header{};
+    if (size < FILE_HEADER_SIZE) {
+        log_error("Replay file too small: {} bytes", size);
+        return false;
+    }
+    std::memcpy(&header, base, sizeof(header));
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION) {
+        log_error("Not a telemetry recording (or unsupported version): {}", path_);
+        return false;
+    }
+    
+    // Without a footer (recorder did not stop cleanly) chunks run to end of file
+    uint64_t limit = header.index_offset != 0 ? std::min<uint64_t>(header.index_offset, size) : size;
+    if (header.index_offset == 0) {
+        log_warn("Recording was not closed cleanly, scanning chunks");
+    }
+    
+    records_.clear();
+    for (uint64_t offset = FILE_HEADER_SIZE; offset + sizeof(ChunkHeader) <= limit; offset += CHUNK_SIZE) {
+        ChunkHeader chunk{};
+        std::memcpy(&chunk, base + offset, sizeof(chunk));
+        
+        // Unsealed chunks have a zero header; their records end at the first End marker
+        uint64_t end = std::min<uint64_t>(offset + CHUNK_SIZE, limit);
+        if (chunk.magic == CHUNK_MAGIC) {
+            end = std::min<uint64_t>(end, offset + chunk.used_bytes);
+        }
+        
+        uint64_t pos = offset + sizeof(ChunkHeader);
+        while (pos + sizeof(RecordHeader) <= end) {
+            RecordHeader record;
+            std::memcpy(&record, base + pos, sizeof(record));
+            if (record.direction == Direction::End ||
+                pos + sizeof(record) + record.length > end) {
+                break;
+            }
+            
+            if (record.direction == Direction::Received &&
+                record.length <= PacketCodec::MAX_PAYLOAD_SIZE) {
+                records_.push_back({record.timestamp_ns, base + pos + sizeof(record), record.length});
+            }
+            pos += sizeof(record) + record.length;
+        }
+    }
+    
+    return true;
+}
+
+void ReplayTransport::close() {
+    if (!is_open_) {
+        return;
+    }
+    
+    log_info("Closing replay transport");
+    
+    is_open_ = false;
+    
+    io_context_.stop();
+    
+    if (io_thread_.joinable()) {
+        io_thread_.join();
+    }
+    
+    framer_.reset();
+    records_.clear();
+    region_ = bip::mapped_region();
+    file_ = bip::file_mapping();
+    
+    log_info("Replay transport closed");
+}
+
+bool ReplayTransport::isOpen() const {
+    return is_open_;
+}
+
+void ReplayTransport::writeAsync(const PacketCodec::EncodedPacket& packet) {
+    // Nobody is listening; count it so send paths still look healthy
+    (void)packet;
+    written_.fetch_add(1, std::memory_order_relaxed);
+}
+
+WriteQueue::Stats ReplayTransport::getWriteStats() const {
+    WriteQueue::Stats stats;
+    stats.packets_written = written_.load(std::memory_order_relaxed);
+    stats.batches_written = stats.packets_written;
+    return stats;
+}
+
+void ReplayTransport::setPacketReceivedCallback(PacketReceivedCallback callback) {
+    {
+        std::lock_guard<std::mutex> lock(callback_mutex_);
+        packet_callback_ = callback;
+    }
+    
+    // Unlike a live link nothing is lost by waiting, so no packet is replayed
+    // before someone is there to receive it
+    if (is_open_ && !started_ && packet_callback_) {
+        started_ = true;
+        start_time_ = std::chrono::steady_clock::now();
+        boost::asio::post(io_context_, [this]() {
+            replayDue();
+        });
+    }
+}
+
+std::string ReplayTransport::getConnectionInfo() const {
+    std::string name = std::filesystem::path(path_).filename().string();
+    if (speed_ > 0.0) {
+        char speed[32];
+        std::snprintf(speed, sizeof(speed), " @ %gx", speed_);
+        return "replay " + name + speed;
+    }
+    return "replay " + name + " @ max";
+}
+
+ReplayTransport::Stats ReplayTransport::getReplayStats() const {
+    Stats stats;
+    stats.packets_replayed = replayed_.load(std::memory_order_relaxed);
+    stats.packets_total = records_.size();
+    
+    int64_t finish_ns = finish_ns_.load(std::memory_order_acquire);
+    stats.finished = finish_ns >= 0;
+    stats.elapsed_s = stats.finished
+        ? finish_ns / 1e9
+        : std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time_).count();
+    if (stats.elapsed_s > 0.0) {
+        stats.packets_per_second = stats.packets_replayed / stats.elapsed_s;
+    }
+    return stats;
+}
+
+void ReplayTransport::replayDue() {
+    if (records_.empty()) {
+        scheduleNext();
+        return;
+    }
+    
+    auto now = std::chrono::steady_clock::now();
+    uint64_t first_timestamp = records_.front().timestamp_ns;
+    
+    // Everything that is due goes to the framer as one contiguous read
+    batch_.clear();
+    size_t count = 0;
+    while (next_record_ < records_.size() && count < MAX_BATCH_RECORDS) {
+        const Record& record = records_[next_record_];
+        if (speed_ > 0.0) {
+            auto offset = std::chrono::nanoseconds(static_cast<int64_t>(
+                (record.timestamp_ns - first_timestamp) / speed_));
+            if (start_time_ + offset > now) {
+                break;
+            }
+        }
+        
+        PacketCodec::EncodedPacket packet;
+        PacketCodec::encodeInto(record.payload, record.length, packet);
+        batch_.insert(batch_.end(), packet.bytes.data(), packet.bytes.data() + packet.size);
+        
+        ++next_record_;
+        ++count;
+    }
+    
+    if (!batch_.empty()) {
+        framer_.feedData(batch_.data(), batch_.size());
+        replayed_.fetch_add(count, std::memory_order_relaxed);
+    }
+    
+    scheduleNext();
+}
+
+void ReplayTransport::scheduleNext() {
+    if (next_record_ >= records_.size()) {
+        auto elapsed = std::chrono::steady_clock::now() - start_time_;
+        finish_ns_.store(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count(),
+                         std::memory_order_release);
+        
+        Stats stats = getReplayStats();
+        log_info("Replay finished: {} packets in {:.3f}s ({:.0f} packets/s)",
+                 stats.packets_replayed, stats.elapsed_s, stats.packets_per_second);
+        return;
+    }
+    
+    if (speed_ <= 0.0) {
+        // Yield between batches so timers and writes on this context still run
+        boost::asio::post(io_context_, [this]() {
+            replayDue();
+        });
+        return;
+    }
+    
+    uint64_t first_timestamp = records_.front().timestamp_ns;
+    auto offset = std::chrono::nanoseconds(static_cast<int64_t>(
+        (records_[next_record_].timestamp_ns - first_timestamp) / speed_));
+    
+    timer_.expires_at(start_time_ + offset);
+    timer_.async_wait([this](const boost::system::error_code& ec) {
+        if (!ec) {
+            replayDue();
+        }
+    });
+}
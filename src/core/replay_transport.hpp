@@ -0,0 +1,94 @@
+#ifndef REPLAY_TRANSPORT_HPP
+#define REPLAY_TRANSPORT_HPP
+
+#include "core/transport_interface.hpp"
+#include "core/packet_framer.hpp"
+#include "core/recording_format.hpp"
+#include <boost/asio.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Replays a TelemetryRecorder file (.oprec) as if it were a live link
+ * 
+ * Received records are re-framed and pushed through a PacketFramer on
+ * this transport's I/O thread, so the backend sees exactly the bytes and
+ * packet order of the original session. Sent records are skipped (the
+ * backend issues its own) and writes are accepted and discarded.
+ * 
+ * Pacing follows the recorded timestamps scaled by speed; speed 0 replays
+ * as fast as possible, in batches so timers on the same io_context still run.
+ */
+class ReplayTransport : public ITransport {
+public:
+    static constexpr double MAX_SPEED = 0.0;
+    
+    struct Stats {
+        uint64_t packets_replayed = 0;
+        uint64_t packets_total = 0;
+        double elapsed_s = 0.0;
+        double packets_per_second = 0.0;
+        bool finished = false;
+    };
+    
+    ReplayTransport(const std::string& path, double speed = 1.0);
+    ~ReplayTransport() override;
+    
+    bool open() override;
+    void close() override;
+    bool isOpen() const override;
+    void writeAsync(const PacketCodec::EncodedPacket& packet) override;
+    WriteQueue::Stats getWriteStats() const override;
+    void setPacketReceivedCallback(PacketReceivedCallback callback) override;
+    boost::asio::io_context& getIoContext() override { return io_context_; }
+    std::string getConnectionInfo() const override;
+    
+    Stats getReplayStats() const;
+    
+private:
+    // Location of one received payload inside the mapped file
+    struct Record {
+        uint64_t timestamp_ns;
+        const uint8_t* payload;
+        uint8_t length;
+    };
+    
+    bool loadRecords();
+    void scheduleNext();
+    void replayDue();
+    
+    std::string path_;
+    double speed_;
+    
+    boost::interprocess::file_mapping file_;
+    boost::interprocess::mapped_region region_;
+    std::vector<Record> records_;
+    size_t next_record_;
+    
+    boost::asio::io_context io_context_;
+    boost::asio::steady_timer timer_;
+    boost::asio::executor_work_guard<boost::asio::io_context::executor_type> work_guard_;
+    std::thread io_thread_;
+    
+    std::chrono::steady_clock::time_point start_time_;
+    std::vector<uint8_t> batch_;    // Re-framed bytes handed to the framer per wake-up
+    PacketFramer framer_;
+    
+    PacketReceivedCallback packet_callback_;
+    std::mutex callback_mutex_;
+    
+    std::atomic<uint64_t> replayed_;
+    std::atomic<uint64_t> written_;
+    std::atomic<int64_t> finish_ns_;    // Elapsed at the last record, -1 while running
+    
+    bool is_open_;
+    bool started_;
+};
+
+#endif // REPLAY_TRANSPORT_HPP
@@ -1,18 +1,24 @@
 #include "core/serial_transport.hpp"
+#include "core/io_context_pool.hpp"
 #include "util/logging.hpp"
 
-SerialTransport::SerialTransport(const std::string& port, uint32_t baud_rate)
+SerialTransport::SerialTransport(const std::string& port, uint32_t baud_rate,
+                                 boost::asio::io_context* shared_io_context)
     : port_(port)
     , baud_rate_(baud_rate)
+    , owned_io_context_(shared_io_context ? nullptr : std::make_unique<boost::asio::io_context>())
+    , io_context_(shared_io_context ? *shared_io_context : *owned_io_context_)
     , serial_port_(io_context_)
     , work_guard_(boost::asio::make_work_guard(io_context_))
-    , framer_([this](const std::vector<uint8_t>& packet) {
+    , io_active_(false)
+    , framer_([this](PacketView packet) {
           // Framer delivers complete packets
           std::lock_guard<std::mutex> lock(callback_mutex_);
           if (packet_callback_) {
               packet_callback_(packet);
           }
       })
+    , metrics_(nullptr)
     , is_open_(false) {
 }
 
@@ -35,18 +41,23 @@ bool SerialTransport::open() {
         serial_port_.set_option(boost::asio::serial_port_base::parity(boost::asio::serial_port_base::parity:: none));
         serial_port_. set_option(boost::asio::serial_port_base::stop_bits(boost::asio:: serial_port_base::stop_bits::one));
         
-        io_thread_ = std::thread([this]() {
-            log_debug("Serial I/O thread started");
-            io_context_.run();
-            log_debug("Serial I/O thread stopped");
-        });
+        if (owned_io_context_) {
+            // Reopening after close(): let the context run again
+            io_context_.restart();
+            io_thread_ = std::thread([this]() {
+                log_debug("Serial I/O thread started");
+                io_context_.run();
+                log_debug("Serial I/O thread stopped");
+            });
+        }
+        io_active_ = true;
         
         startAsyncRead();
         
         is_open_ = true;
         log_info("Serial transport opened successfully");
         return true;
-        
+    
     } catch (const boost::system::system_error& e) {
         log_error("Failed to open serial:   {}", e.what());
         return false;
@@ -54,7 +65,8 @@ bool SerialTransport::open() {
 }
 
 void SerialTransport:: close() {
-    if (!is_open_) {
+    // After a lost link the port is still open and its I/O must be stopped
+    if (!is_open_ && !io_active_) {
         return;
     }
     
@@ -62,23 +74,35 @@ void SerialTransport:: close() {
     
     is_open_ = false;
     
-    try {
-        serial_port_.close();
-    } catch (const std::exception& e) {
-        log_error("Error closing serial port: {}", e.what());
-    } catch (...) {
-        log_error("Unknown error closing serial port");
-    }
-    
-    io_context_.stop();
+    auto close_port = [this]() {
+        try {
+            if (serial_port_.is_open()) {
+                serial_port_.close();
+            }
+        } catch (const std::exception& e) {
+            log_error("Error closing serial port: {}", e.what());
+        } catch (...) {
+            log_error("Unknown error closing serial port");
+        }
+    };
     
-    if (io_thread_.joinable()) {
-        log_debug("Joining serial I/O thread");
-        io_thread_.join();
-        log_debug("Serial I/O thread joined");
+    if (owned_io_context_) {
+        close_port();
+        io_context_.stop();
+        
+        if (io_thread_.joinable()) {
+            log_debug("Joining serial I/O thread");
+            io_thread_.join();
+            log_debug("Serial I/O thread joined");
+        }
+    } else {
+        // The context keeps running for other transports: wait out our aborted handlers instead
+        runAndDrain(io_context_, close_port);
     }
+    io_active_ = false;
     
     framer_.reset();
+    write_queue_.clear();
     
     log_info("Serial transport closed");
 }
@@ -87,32 +111,93 @@ bool SerialTransport::isOpen() const {
     return is_open_;
 }
 
-void SerialTransport::writeAsync(const std::vector<uint8_t>& data) {
+void SerialTransport::writeAsync(const PacketCodec::EncodedPacket& packet) {
     if (!is_open_) {
-        log_warn("Attempted write to closed serial");
+        log_warn_limited("Attempted write to closed serial");
         return;
     }
     
-    auto buffer = std::make_shared<std::vector<uint8_t>>(data);
+    bool start_write = false;
+    if (!write_queue_.push(packet, start_write)) {
+        log_warn_limited("Serial write queue full, dropping {}-byte packet", packet.size);
+        return;
+    }
     
+    // Writes are only ever issued from the I/O thread, one at a time
+    if (start_write) {
+        boost::asio::post(io_context_, [this]() {
+            startWrite();
+        });
+    }
+}
+
+void SerialTransport::startWrite() {
+    auto batch = write_queue_.beginBatch();
+    if (batch.empty()) {
+        return;
+    }
+    
+    // One gather write for everything queued; slot memory stays valid until completeBatch()
     boost::asio::async_write(
         serial_port_,
-        boost::asio::buffer(*buffer),
-        [buffer](const boost::system::error_code& ec, size_t bytes_written) {
-            if (ec) {
-                log_error("Serial write error: {}", ec.message());
-            } else {
-                log_debug("Wrote {} bytes to serial", bytes_written);
-            }
+        batch,
+        [this](const boost::system::error_code& ec, size_t bytes_written) {
+            handleWrite(ec, bytes_written);
         }
     );
 }
 
+void SerialTransport::handleWrite(const boost::system::error_code& ec, size_t bytes_written) {
+    if (ec) {
+        if (ec != boost::asio::error::operation_aborted) {
+            log_error("Serial write error: {}", ec.message());
+            notifyLinkLost("Serial write error: " + ec.message());
+        }
+        write_queue_.clear();
+        return;
+    }
+    
+    log_debug("Wrote {} bytes to serial", bytes_written);
+    if (metrics_) {
+        metrics_->bytes_out.add(bytes_written);
+    }
+    
+    if (write_queue_.completeBatch()) {
+        startWrite();
+    }
+}
+
 void SerialTransport:: setPacketReceivedCallback(PacketReceivedCallback callback) {
     std::lock_guard<std::mutex> lock(callback_mutex_);
     packet_callback_ = callback;
 }
 
+void SerialTransport::setLinkLostCallback(LinkLostCallback callback) {
+    std::lock_guard<std::mutex> lock(callback_mutex_);
+    link_lost_callback_ = callback;
+}
+
+void SerialTransport::setMetrics(LinkMetrics* metrics) {
+    metrics_ = metrics;
+    framer_.setMetrics(metrics);
+}
+
+void SerialTransport::notifyLinkLost(const std::string& reason) {
+    // Read and write may both fail for the same glitch; report it once
+    if (!is_open_.exchange(false)) {
+        return;
+    }
+    
+    LinkLostCallback callback;
+    {
+        std::lock_guard<std::mutex> lock(callback_mutex_);
+        callback = link_lost_callback_;
+    }
+    if (callback) {
+        callback(reason);
+    }
+}
+
 std::string SerialTransport:: getConnectionInfo() const {
     return port_ + " @ " + std::to_string(baud_rate_) + " baud";
 }
@@ -130,11 +215,15 @@ void SerialTransport::handleReadSome(const boost::system::error_code& ec, size_t
     if (ec) {
         if (ec != boost::asio::error::operation_aborted) {
             log_error("Serial read error: {}", ec. message());
+            notifyLinkLost("Serial read error: " + ec.message());
         }
         return;
     }
     
     log_debug("Read {} bytes from serial", bytes_read);
+    if (metrics_) {
+        metrics_->bytes_in.add(bytes_read);
+    }
     
     // ✅ Just feed data to framer - it handles everything! 
     framer_.feedData(temp_read_buffer_.data(), bytes_read);
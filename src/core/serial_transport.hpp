@@ -3,43 +3,63 @@
 
 #include "core/transport_interface.hpp"
 #include "core/packet_framer.hpp"
+#include "core/write_queue.hpp"
 #include <boost/asio.hpp>
 #include <thread>
 #include <mutex>
 #include <array>
+#include <atomic>
+#include <memory>
 
 class SerialTransport : public ITransport {
 public:
-    SerialTransport(const std::string& port, uint32_t baud_rate);
+    /**
+     * @param shared_io_context Run on this (already running) context instead of
+     *        an own I/O thread, e.g. one from an IoContextPool
+     */
+    SerialTransport(const std::string& port, uint32_t baud_rate,
+                    boost::asio::io_context* shared_io_context = nullptr);
     ~SerialTransport() override;
     
     bool open() override;
     void close() override;
     bool isOpen() const override;
-    void writeAsync(const std::vector<uint8_t>& data) override;
+    void writeAsync(const PacketCodec::EncodedPacket& packet) override;
+    WriteQueue::Stats getWriteStats() const override { return write_queue_.getStats(); }
     void setPacketReceivedCallback(PacketReceivedCallback callback) override;
+    void setLinkLostCallback(LinkLostCallback callback) override;
+    void setMetrics(LinkMetrics* metrics) override;
     boost::asio::io_context& getIoContext() override { return io_context_; }
     std::string getConnectionInfo() const override;
     
 private:
     void startAsyncRead();
     void handleReadSome(const boost::system::error_code& ec, size_t bytes_read);
+    void startWrite();
+    void handleWrite(const boost::system::error_code& ec, size_t bytes_written);
+    void notifyLinkLost(const std::string& reason);
     
     std::string port_;
     uint32_t baud_rate_;
     
-    boost::asio::io_context io_context_;
+    std::unique_ptr<boost::asio::io_context> owned_io_context_;  // Null when shared
+    boost::asio::io_context& io_context_;
     boost::asio::serial_port serial_port_;
     boost::asio::executor_work_guard<boost::asio::io_context::executor_type> work_guard_;
-    std::thread io_thread_;
+    std::thread io_thread_;     // Only with an owned context
+    bool io_active_;            // Between open() and close(), even after a lost link
     
     std::array<uint8_t, 1024> temp_read_buffer_;
     PacketFramer framer_;
+    WriteQueue write_queue_;
     
     PacketReceivedCallback packet_callback_;
+    LinkLostCallback link_lost_callback_;
     std::mutex callback_mutex_;
     
-    bool is_open_;
+    LinkMetrics* metrics_;      // Null until setMetrics()
+    
+    std::atomic<bool> is_open_;     // Cleared on the I/O thread when the link is lost
 };
 
 #endif // SERIAL_TRANSPORT_HPP
@@ -0,0 +1,103 @@
+#include "core/socket_profile.hpp"
+#include "util/logging.hpp"
+#include <boost/asio/socket_base.hpp>
+#include <cstddef>
+
+#ifdef __linux__
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#endif
+
+namespace {
+    template<typename Option>
+    void setOption(boost::asio::ip::tcp::socket& socket, const Option& option, const char* name) {
+        boost::system::error_code ec;
+        socket.set_option(option, ec);
+        if (ec) {
+            log_warn("Could not set {}: {}", name, ec.message());
+        }
+    }
+
+#ifdef __linux__
+    /**
+     * Integer socket option, satisfying Asio's SettableSocketOption requirements
+     */
+    template<int Level, int Name>
+    class IntOption {
+    public:
+        explicit IntOption(int value) : value_(value) {}
+        
+        template<typename Protocol>
+        int level(const Protocol&) const { return Level; }
+        
+        template<typename Protocol>
+        int name(const Protocol&) const { return Name; }
+        
+        template<typename Protocol>
+        const int* data(const Protocol&) const { return &value_; }
+        
+        template<typename Protocol>
+        std::size_t size(const Protocol&) const { return sizeof(value_); }
+        
+    private:
+        int value_;
+    };
+#endif
+}
+
+void applySocketBuffers(boost::asio::ip::tcp::socket& socket, const SocketProfile& profile) {
+    if (profile.receive_buffer_bytes <= 0 && profile.send_buffer_bytes <= 0) {
+        return;
+    }
+    
+    if (profile.receive_buffer_bytes > 0) {
+        setOption(socket, boost::asio::socket_base::receive_buffer_size(profile.receive_buffer_bytes), "SO_RCVBUF");
+    }
+    if (profile.send_buffer_bytes > 0) {
+        setOption(socket, boost::asio::socket_base::send_buffer_size(profile.send_buffer_bytes), "SO_SNDBUF");
+    }
+    
+    // The kernel may round or clamp (Linux doubles SO_RCVBUF), so log what we got
+    boost::asio::socket_base::receive_buffer_size receive_size;
+    boost::asio::socket_base::send_buffer_size send_size;
+    boost::system::error_code ec;
+    socket.get_option(receive_size, ec);
+    socket.get_option(send_size, ec);
+    if (!ec) {
+        log_debug("Socket buffers: receive {} bytes, send {} bytes", receive_size.value(), send_size.value());
+    }
+}
+
+void applySocketProfile(boost::asio::ip::tcp::socket& socket, const SocketProfile& profile) {
+    log_info("Applying socket profile: {}", profile.name);
+    
+    if (profile.no_delay) {
+        setOption(socket, boost::asio::ip::tcp::no_delay(true), "TCP_NODELAY");
+    }
+    if (profile.keepalive) {
+        setOption(socket, boost::asio::socket_base::keep_alive(true), "SO_KEEPALIVE");
+    }
+
+#ifdef __linux__
+    if (profile.keepalive && profile.keepalive_idle_s > 0) {
+        setOption(socket, IntOption<IPPROTO_TCP, TCP_KEEPIDLE>(profile.keepalive_idle_s), "TCP_KEEPIDLE");
+    }
+    if (profile.keepalive && profile.keepalive_interval_s > 0) {
+        setOption(socket, IntOption<IPPROTO_TCP, TCP_KEEPINTVL>(profile.keepalive_interval_s), "TCP_KEEPINTVL");
+    }
+    if (profile.keepalive && profile.keepalive_count > 0) {
+        setOption(socket, IntOption<IPPROTO_TCP, TCP_KEEPCNT>(profile.keepalive_count), "TCP_KEEPCNT");
+    }
+    if (profile.user_timeout_ms > 0) {
+        setOption(socket, IntOption<IPPROTO_TCP, TCP_USER_TIMEOUT>(profile.user_timeout_ms), "TCP_USER_TIMEOUT");
+    }
+    if (profile.busy_poll_us > 0) {
+        setOption(socket, IntOption<SOL_SOCKET, SO_BUSY_POLL>(profile.busy_poll_us), "SO_BUSY_POLL");
+    }
+#else
+    if (profile.keepalive_idle_s > 0 || profile.user_timeout_ms > 0 || profile.busy_poll_us > 0) {
+        log_debug("Keepalive timing, user timeout and busy-poll are not supported on this platform");
+    }
+#endif
+}
@@ -0,0 +1,80 @@
+#ifndef SOCKET_PROFILE_HPP
+#define SOCKET_PROFILE_HPP
+
+#include <boost/asio/ip/tcp.hpp>
+#include <cstdint>
+
+/**
+ * TCP socket options applied by NetworkTransport around connect
+ * 
+ * Buffer sizes go on the open socket before connecting: Linux picks the
+ * TCP window scale from SO_RCVBUF during the handshake. Everything else
+ * is applied once connected.
+ * 
+ * Zero means "leave the OS default". Options the platform does not have
+ * (keepalive timing, user timeout and busy-poll are Linux-specific) are
+ * skipped with a debug log; any option the kernel refuses is logged and
+ * the connection carries on without it.
+ */
+struct SocketProfile {
+    const char* name = "OS default";
+    
+    bool no_delay = false;              // TCP_NODELAY: don't hold small packets back (Nagle)
+    int receive_buffer_bytes = 0;       // SO_RCVBUF
+    int send_buffer_bytes = 0;          // SO_SNDBUF
+    
+    // Dead-link detection
+    bool keepalive = false;             // SO_KEEPALIVE
+    int keepalive_idle_s = 0;           // TCP_KEEPIDLE: idle time before the first probe
+    int keepalive_interval_s = 0;       // TCP_KEEPINTVL
+    int keepalive_count = 0;            // TCP_KEEPCNT: unanswered probes before reset
+    int user_timeout_ms = 0;            // TCP_USER_TIMEOUT: unacked data before reset
+    
+    int busy_poll_us = 0;               // SO_BUSY_POLL: spin in the driver on read (costs CPU)
+    
+    /**
+     * Kernel defaults, i.e. what NetworkTransport did before profiles existed
+     */
+    static SocketProfile osDefault() { return SocketProfile{}; }
+    
+    /**
+     * Nagle off, small buffers so nothing queues behind a stale setpoint,
+     * and a dead link is reset within about 3 s
+     */
+    static SocketProfile lowLatency() {
+        SocketProfile profile;
+        profile.name = "Low latency";
+        profile.no_delay = true;
+        profile.receive_buffer_bytes = 64 * 1024;
+        profile.send_buffer_bytes = 16 * 1024;
+        profile.keepalive = true;
+        profile.keepalive_idle_s = 1;
+        profile.keepalive_interval_s = 1;
+        profile.keepalive_count = 2;
+        profile.user_timeout_ms = 3000;
+        return profile;
+    }
+    
+    /**
+     * lowLatency() plus busy-polling the receive queue for 50 us
+     */
+    static SocketProfile busyPoll() {
+        SocketProfile profile = lowLatency();
+        profile.name = "Low latency + busy poll";
+        profile.busy_poll_us = 50;
+        return profile;
+    }
+};
+
+/**
+ * Apply a profile's buffer sizes to an open, not yet connected socket
+ * (best effort, see SocketProfile)
+ */
+void applySocketBuffers(boost::asio::ip::tcp::socket& socket, const SocketProfile& profile);
+
+/**
+ * Apply the rest of a profile to a connected socket (best effort)
+ */
+void applySocketProfile(boost::asio::ip::tcp::socket& socket, const SocketProfile& profile);
+
+#endif // SOCKET_PROFILE_HPP
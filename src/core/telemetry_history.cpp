@@ -0,0 +1,53 @@
+#include "core/telemetry_history.hpp"
+#include <algorithm>
+
+TelemetryHistory::TelemetryHistory()
+    : epoch_(std::chrono::steady_clock::now())
+    , time_(CAPACITY * 2)
+    , pan_position_(CAPACITY * 2)
+    , pan_setpoint_(CAPACITY * 2)
+    , write_index_(0) {
+}
+
+double TelemetryHistory::now() const {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - epoch_).count();
+}
+
+void TelemetryHistory::append(float pan_position, float pan_setpoint) {
+    uint64_t index = write_index_.load(std::memory_order_relaxed);
+    size_t slot = static_cast<size_t>(index % CAPACITY);
+    double time = now();
+    
+    // Mirror each sample so any window of recent samples is contiguous
+    time_[slot] = time;
+    time_[slot + CAPACITY] = time;
+    pan_position_[slot] = pan_position;
+    pan_position_[slot + CAPACITY] = pan_position;
+    pan_setpoint_[slot] = pan_setpoint;
+    pan_setpoint_[slot + CAPACITY] = pan_setpoint;
+    
+    write_index_.store(index + 1, std::memory_order_release);
+}
+
+TelemetryHistory::View TelemetryHistory::getView(size_t max_samples) const {
+    uint64_t end = write_index_.load(std::memory_order_acquire);
+    size_t count = static_cast<size_t>(std::min<uint64_t>(end, std::min(max_samples, MAX_VIEW)));
+    
+    View view;
+    view.end_index = end;
+    if (count == 0) {
+        return view;
+    }
+    
+    // Start in the lower copy; the mirror supplies the part past the wrap
+    size_t start = static_cast<size_t>((end - count) % CAPACITY);
+    view.time = time_.data() + start;
+    view.pan_position = pan_position_.data() + start;
+    view.pan_setpoint = pan_setpoint_.data() + start;
+    view.count = count;
+    return view;
+}
+
+void TelemetryHistory::clear() {
+    write_index_.store(0, std::memory_order_release);
+}
@@ -0,0 +1,81 @@
+#ifndef TELEMETRY_HISTORY_HPP
+#define TELEMETRY_HISTORY_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Fixed-capacity history of timestamped telemetry samples
+ * 
+ * Struct-of-arrays ring buffer, allocated once. Every sample is stored
+ * twice (at i and i + CAPACITY), so any run of recent samples is one
+ * contiguous span per series that can go straight to ImPlot without
+ * copying.
+ * 
+ * Single writer (the I/O thread, via GimbalState), lock-free readers.
+ * A View stays valid while the writer appends fewer than READ_GUARD
+ * samples, which at streaming rates is minutes - far longer than a frame.
+ */
+class TelemetryHistory {
+public:
+    static constexpr size_t CAPACITY = size_t(1) << 16;     // ~21 min at 50 Hz
+    static constexpr size_t READ_GUARD = CAPACITY / 8;
+    static constexpr size_t MAX_VIEW = CAPACITY - READ_GUARD;
+    
+    /**
+     * Contiguous spans over the most recent samples (oldest first)
+     */
+    struct View {
+        const double* time = nullptr;          // Seconds since the history epoch
+        const double* pan_position = nullptr;  // Degrees
+        const double* pan_setpoint = nullptr;  // Degrees
+        size_t count = 0;
+        uint64_t end_index = 0;                // Total samples appended when the view was taken
+        
+        bool empty() const { return count == 0; }
+    };
+    
+    TelemetryHistory();
+    
+    TelemetryHistory(const TelemetryHistory&) = delete;
+    TelemetryHistory& operator=(const TelemetryHistory&) = delete;
+    
+    /**
+     * Append a sample stamped with the current time (writer thread only)
+     */
+    void append(float pan_position, float pan_setpoint);
+    
+    /**
+     * Lock-free view of up to max_samples most recent samples
+     */
+    View getView(size_t max_samples = MAX_VIEW) const;
+    
+    /**
+     * Samples ever appended (monotonic, for change detection)
+     */
+    uint64_t getTotalSamples() const { return write_index_.load(std::memory_order_acquire); }
+    
+    /**
+     * Seconds since the history epoch, on the same clock as View::time
+     */
+    double now() const;
+    
+    /**
+     * Drop all samples (only while no writer is running, e.g. after disconnect)
+     */
+    void clear();
+    
+private:
+    std::chrono::steady_clock::time_point epoch_;
+    
+    std::vector<double> time_;
+    std::vector<double> pan_position_;
+    std::vector<double> pan_setpoint_;
+    
+    std::atomic<uint64_t> write_index_;
+};
+
+#endif // TELEMETRY_HISTORY_HPP
@@ -0,0 +1,338 @@
+#include "core/telemetry_recorder.hpp"
+#include "util/logging.hpp"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace bip = boost::interprocess;
+using namespace RecordingFormat;
+
+TelemetryRecorder::TelemetryRecorder()
+    : recording_(false)
+    , records_(0)
+    , bytes_(0)
+    , dropped_(0) {
+}
+
+TelemetryRecorder::~TelemetryRecorder() {
+    stop();
+}
+
+void TelemetryRecorder::lock() const {
+    // Held for a memcpy of at most 72 bytes; yield in case the holder was preempted
+    while (spin_.test_and_set(std::memory_order_acquire)) {
+        std::this_thread::yield();
+    }
+}
+
+void TelemetryRecorder::unlock() const {
+    spin_.clear(std::memory_order_release);
+}
+
+bool TelemetryRecorder::start(const std::string& path) {
+    stop();
+    
+    try {
+        std::filesystem::path file_path(path);
+        if (file_path.has_parent_path()) {
+            std::filesystem::create_directories(file_path.parent_path());
+        }
+        
+        start_time_ = std::chrono::steady_clock::now();
+        start_unix_ns_ = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count());
+        
+        // Header now (index_offset 0 = not closed cleanly), chunks are mapped after it
+        FileHeader header{};
+        std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+        header.version = VERSION;
+        header.chunk_size = static_cast<uint32_t>(CHUNK_SIZE);
+        header.start_unix_ns = start_unix_ns_;
+        
+        {
+            std::ofstream out(path, std::ios::binary | std::ios::trunc);
+            if (!out) {
+                log_error("Cannot create recording file: {}", path);
+                return false;
+            }
+            std::vector<char> page(FILE_HEADER_SIZE, 0);
+            std::memcpy(page.data(), &header, sizeof(header));
+            out.write(page.data(), static_cast<std::streamsize>(page.size()));
+        }
+        
+        path_ = path;
+        file_ = bip::file_mapping(path.c_str(), bip::read_write);
+        
+        index_.clear();
+        retired_.clear();
+        retired_.reserve(4);
+        records_ = 0;
+        bytes_ = 0;
+        dropped_ = 0;
+        
+        // Start with a spare so the worker is a whole chunk ahead from the outset
+        current_ = mapChunk(0);
+        next_ = mapChunk(1);
+        next_chunk_index_ = 2;
+        
+        worker_running_ = true;
+        worker_ = std::thread([this]() { backgroundLoop(); });
+        
+        recording_.store(true, std::memory_order_release);
+        log_info("Recording telemetry to {}", path_);
+        return true;
+    
+    } catch (const std::exception& e) {
+        log_error("Failed to start recording {}: {}", path, e.what());
+        current_ = Chunk{};
+        next_ = Chunk{};
+        file_ = bip::file_mapping();
+        return false;
+    }
+}
+
+void TelemetryRecorder::stop() {
+    if (!recording_.exchange(false, std::memory_order_acq_rel)) {
+        return;
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(worker_mutex_);
+        worker_running_ = false;
+    }
+    worker_cv_.notify_one();
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+    
+    try {
+        finish();
+    } catch (const std::exception& e) {
+        log_error("Failed to finalize recording {}: {}", path_, e.what());
+    }
+}
+
+std::string TelemetryRecorder::getPath() const {
+    return path_;
+}
+
+TelemetryRecorder::Stats TelemetryRecorder::getStats() const {
+    Stats stats;
+    stats.records = records_.load(std::memory_order_relaxed);
+    stats.bytes = bytes_.load(std::memory_order_relaxed);
+    stats.dropped = dropped_.load(std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(index_mutex_);
+        stats.chunks = static_cast<uint32_t>(index_.size()) + (isRecording() ? 1 : 0);
+    }
+    if (isRecording()) {
+        stats.duration_s = std::chrono::duration<double>(
+            std::chrono::steady_clock::now() - start_time_).count();
+    }
+    return stats;
+}
+
+void TelemetryRecorder::record(Direction direction, const uint8_t* data, size_t length) {
+    if (!recording_.load(std::memory_order_acquire)) {
+        return;
+    }
+    if (length > UINT8_MAX) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    
+    RecordHeader header;
+    header.direction = direction;
+    header.length = static_cast<uint8_t>(length);
+    size_t needed = sizeof(RecordHeader) + length;
+    bool rotated = false;
+    
+    lock();
+    
+    if (!current_.base || current_.used + needed > CHUNK_SIZE) {
+        if (!next_.base) {
+            // Mapper has fallen behind (or we are stopping) - never wait for it
+            unlock();
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        if (current_.base) {
+            retired_.push_back(std::move(current_));
+        }
+        current_ = std::move(next_);
+        next_ = Chunk{};
+        rotated = true;
+    }
+    
+    // Stamped under the lock so records are in time order across threads
+    header.timestamp_ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - start_time_).count());
+    
+    uint8_t* out = current_.base + current_.used;
+    std::memcpy(out, &header, sizeof(header));
+    std::memcpy(out + sizeof(header), data, length);
+    current_.used += needed;
+    if (current_.record_count++ == 0) {
+        current_.first_timestamp_ns = header.timestamp_ns;
+    }
+    current_.last_timestamp_ns = header.timestamp_ns;
+    
+    unlock();
+    
+    records_.fetch_add(1, std::memory_order_relaxed);
+    bytes_.fetch_add(needed, std::memory_order_relaxed);
+    
+    if (rotated) {
+        // Once per chunk; the worker only holds this mutex to check the flag
+        {
+            std::lock_guard<std::mutex> lock(worker_mutex_);
+            worker_pending_ = true;
+        }
+        worker_cv_.notify_one();
+    }
+}
+
+TelemetryRecorder::Chunk TelemetryRecorder::mapChunk(uint32_t index) {
+    // Grow the file to cover the chunk; new pages read as zero (= End records)
+    std::filesystem::resize_file(path_, chunkOffset(index) + CHUNK_SIZE);
+    
+    Chunk chunk;
+    chunk.region = std::make_unique<bip::mapped_region>(
+        file_, bip::read_write, chunkOffset(index), CHUNK_SIZE);
+    chunk.index = index;
+    chunk.base = static_cast<uint8_t*>(chunk.region->get_address());
+    chunk.used = sizeof(ChunkHeader);
+    
+    // Fault the pages in here, on the worker, not on the I/O thread mid-record
+    size_t page_size = bip::mapped_region::get_page_size();
+    for (size_t offset = 0; offset < CHUNK_SIZE; offset += page_size) {
+        chunk.base[offset] = 0;
+    }
+    return chunk;
+}
+
+void TelemetryRecorder::sealChunk(Chunk& chunk) {
+    ChunkHeader header{};
+    header.magic = CHUNK_MAGIC;
+    header.chunk_index = chunk.index;
+    header.first_timestamp_ns = chunk.first_timestamp_ns;
+    header.last_timestamp_ns = chunk.last_timestamp_ns;
+    header.record_count = chunk.record_count;
+    header.used_bytes = static_cast<uint32_t>(chunk.used);
+    std::memcpy(chunk.base, &header, sizeof(header));
+    
+    // Start write-back now rather than at unmap
+    chunk.region->flush(0, chunk.used, true);
+    
+    ChunkIndexEntry entry{};
+    entry.offset = chunkOffset(chunk.index);
+    entry.first_timestamp_ns = chunk.first_timestamp_ns;
+    entry.last_timestamp_ns = chunk.last_timestamp_ns;
+    entry.record_count = chunk.record_count;
+    entry.used_bytes = header.used_bytes;
+    {
+        std::lock_guard<std::mutex> lock(index_mutex_);
+        index_.push_back(entry);
+    }
+    
+    chunk.region.reset();
+    chunk.base = nullptr;
+}
+
+void TelemetryRecorder::backgroundLoop() {
+    std::unique_lock<std::mutex> worker_lock(worker_mutex_);
+    
+    while (worker_running_) {
+        worker_pending_ = false;
+        worker_lock.unlock();
+        
+        // Keep one chunk mapped ahead so record() never touches the file system
+        lock();
+        bool need_next = !next_.base;
+        unlock();
+        
+        if (need_next) {
+            try {
+                Chunk chunk = mapChunk(next_chunk_index_);
+                ++next_chunk_index_;
+                lock();
+                next_ = std::move(chunk);
+                unlock();
+            } catch (const std::exception& e) {
+                log_error("Recorder failed to map chunk {}: {}", next_chunk_index_, e.what());
+            }
+        }
+        
+        std::vector<Chunk> retired;
+        lock();
+        retired.swap(retired_);
+        retired_.reserve(4);
+        unlock();
+        
+        for (auto& chunk : retired) {
+            sealChunk(chunk);
+        }
+        
+        worker_lock.lock();
+        worker_cv_.wait(worker_lock, [this]() { return worker_pending_ || !worker_running_; });
+    }
+}
+
+void TelemetryRecorder::finish() {
+    lock();
+    Chunk last = std::move(current_);
+    current_ = Chunk{};
+    Chunk spare = std::move(next_);
+    next_ = Chunk{};
+    std::vector<Chunk> retired;
+    retired.swap(retired_);
+    unlock();
+    
+    for (auto& chunk : retired) {
+        sealChunk(chunk);
+    }
+    
+    uint64_t end_offset = FILE_HEADER_SIZE;
+    if (last.base) {
+        end_offset = chunkOffset(last.index) + last.used;
+        sealChunk(last);
+    }
+    spare.region.reset();
+    file_ = bip::file_mapping();
+    
+    // Drop the unused tail of the last chunk and the pre-mapped spare
+    std::filesystem::resize_file(path_, end_offset);
+    
+    std::vector<ChunkIndexEntry> index;
+    {
+        std::lock_guard<std::mutex> lock(index_mutex_);
+        index = index_;
+    }
+    std::sort(index.begin(), index.end(), [](const ChunkIndexEntry& a, const ChunkIndexEntry& b) {
+        return a.offset < b.offset;
+    });
+    
+    FileHeader header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.chunk_size = static_cast<uint32_t>(CHUNK_SIZE);
+    header.start_unix_ns = start_unix_ns_;
+    header.index_offset = end_offset;
+    header.chunk_count = static_cast<uint32_t>(index.size());
+    
+    std::fstream out(path_, std::ios::binary | std::ios::in | std::ios::out);
+    out.seekp(static_cast<std::streamoff>(end_offset));
+    out.write(reinterpret_cast<const char*>(index.data()),
+              static_cast<std::streamsize>(index.size() * sizeof(ChunkIndexEntry)));
+    out.seekp(0);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    
+    if (!out) {
+        log_error("Failed to write recording index: {}", path_);
+        return;
+    }
+    
+    log_info("Recording closed: {} ({} records, {} chunks, {} dropped)",
+             path_, records_.load(), index.size(), dropped_.load());
+}
@@ -0,0 +1,110 @@
+#ifndef TELEMETRY_RECORDER_HPP
+#define TELEMETRY_RECORDER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include "core/recording_format.hpp"
+
+/**
+ * Append-only binary recorder for raw packets (see recording_format.hpp)
+ * 
+ * record() is a memcpy into a memory-mapped 1 MiB chunk under a spinlock,
+ * so the I/O thread (received packets) and the GUI thread (sent packets)
+ * never wait on disk. A background thread maps the next chunk ahead of
+ * time and seals, flushes and unmaps full ones. If the writer ever
+ * outruns it, records are dropped and counted rather than blocking.
+ */
+class TelemetryRecorder {
+public:
+    using Direction = RecordingFormat::Direction;
+    
+    struct Stats {
+        uint64_t records = 0;
+        uint64_t bytes = 0;
+        uint64_t dropped = 0;
+        uint32_t chunks = 0;
+        double duration_s = 0.0;
+    };
+    
+    TelemetryRecorder();
+    ~TelemetryRecorder();
+    
+    TelemetryRecorder(const TelemetryRecorder&) = delete;
+    TelemetryRecorder& operator=(const TelemetryRecorder&) = delete;
+    
+    /**
+     * Create (truncate) path and start recording
+     */
+    bool start(const std::string& path);
+    
+    /**
+     * Seal the last chunk and write the index footer
+     */
+    void stop();
+    
+    bool isRecording() const { return recording_.load(std::memory_order_acquire); }
+    std::string getPath() const;
+    Stats getStats() const;
+    
+    /**
+     * Append one packet payload (any thread, never blocks)
+     */
+    void record(Direction direction, const uint8_t* data, size_t length);
+    
+private:
+    struct Chunk {
+        std::unique_ptr<boost::interprocess::mapped_region> region;
+        uint32_t index = 0;
+        uint8_t* base = nullptr;
+        size_t used = 0;
+        uint64_t first_timestamp_ns = 0;
+        uint64_t last_timestamp_ns = 0;
+        uint32_t record_count = 0;
+    };
+    
+    void lock() const;
+    void unlock() const;
+    
+    Chunk mapChunk(uint32_t index);
+    void sealChunk(Chunk& chunk);
+    void backgroundLoop();
+    void finish();
+    
+    std::string path_;
+    boost::interprocess::file_mapping file_;
+    std::chrono::steady_clock::time_point start_time_;
+    uint64_t start_unix_ns_ = 0;
+    
+    // Writer state, guarded by spin_
+    mutable std::atomic_flag spin_ = ATOMIC_FLAG_INIT;
+    Chunk current_;
+    Chunk next_;                    // Pre-mapped by the background thread
+    std::vector<Chunk> retired_;    // Full chunks waiting to be sealed
+    
+    std::atomic<bool> recording_;
+    std::atomic<uint64_t> records_;
+    std::atomic<uint64_t> bytes_;
+    std::atomic<uint64_t> dropped_;
+    
+    // Background mapper/sealer
+    std::thread worker_;
+    std::mutex worker_mutex_;
+    std::condition_variable worker_cv_;
+    bool worker_running_ = false;
+    bool worker_pending_ = false;   // A chunk was consumed since the last pass
+    uint32_t next_chunk_index_ = 0;
+    std::vector<RecordingFormat::ChunkIndexEntry> index_;
+    mutable std::mutex index_mutex_;
+};
+
+#endif // TELEMETRY_RECORDER_HPP
@@ -1,11 +1,16 @@
 #ifndef TRANSPORT_INTERFACE_HPP
 #define TRANSPORT_INTERFACE_HPP
 
+#include "core/packet_view.hpp"
+#include "core/packet_codec.hpp"
+#include "core/write_queue.hpp"
 #include <vector>
 #include <functional>
 #include <cstdint>
 #include <string>
 
+struct LinkMetrics;
+
 namespace boost {
 namespace asio {
     class io_context;
@@ -18,7 +23,10 @@ namespace asio {
  */
 class ITransport {
 public:
-    using PacketReceivedCallback = std::function<void(const std::vector<uint8_t>&)>;
+    // The view is only valid for the duration of the callback; copy the
+    // bytes to keep them. Transports may reuse the memory straight after.
+    using PacketReceivedCallback = std::function<void(PacketView)>;
+    using LinkLostCallback = std::function<void(const std::string& reason)>;
     
     virtual ~ITransport() = default;
     
@@ -38,15 +46,37 @@ public:
     virtual bool isOpen() const = 0;
     
     /**
-     * Write raw bytes asynchronously
+     * Queue an encoded packet for asynchronous writing
+     * Packets are written in order; everything queued while a write is in
+     * flight goes out together in the next gather write
      */
-    virtual void writeAsync(const std::vector<uint8_t>& data) = 0;
+    virtual void writeAsync(const PacketCodec::EncodedPacket& packet) = 0;
+    
+    /**
+     * Outbound queue depth, bytes in flight and coalescing counters
+     */
+    virtual WriteQueue::Stats getWriteStats() const = 0;
     
     /**
      * Set callback for received packets
      */
     virtual void setPacketReceivedCallback(PacketReceivedCallback callback) = 0;
     
+    /**
+     * Set callback for an open link failing underneath us (read/write error,
+     * peer closed). Called once per open, on the I/O thread, after isOpen()
+     * has turned false; never called for close(). Transports that cannot
+     * detect a lost link never call it.
+     */
+    virtual void setLinkLostCallback(LinkLostCallback callback) { (void)callback; }
+    
+    /**
+     * Count raw bytes, framing errors etc. into a link's metrics, which the
+     * caller keeps alive as long as the transport. Set before open().
+     * Transports without a raw byte stream ignore it.
+     */
+    virtual void setMetrics(LinkMetrics* metrics) { (void)metrics; }
+    
     /**
      * Get the io_context for this transport (for timers, etc.)
      */
@@ -0,0 +1,302 @@
+#include "core/udp_transport.hpp"
+#include "core/io_context_pool.hpp"
+#include "util/logging.hpp"
+
+#ifdef __linux__
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <cerrno>
+#include <cstring>
+#endif
+
+UdpTransport::UdpTransport(const std::string& host, uint16_t port,
+                           boost::asio::io_context* shared_io_context)
+    : host_(host)
+    , port_(port)
+    , owned_io_context_(shared_io_context ? nullptr : std::make_unique<boost::asio::io_context>())
+    , io_context_(shared_io_context ? *shared_io_context : *owned_io_context_)
+    , socket_(io_context_)
+    , work_guard_(boost::asio::make_work_guard(io_context_))
+    , metrics_(nullptr)
+    , datagrams_received_(0)
+    , datagrams_sent_(0)
+    , receive_calls_(0)
+    , send_calls_(0)
+    , malformed_(0)
+    , is_open_(false) {
+}
+
+UdpTransport::~UdpTransport() {
+    close();
+}
+
+bool UdpTransport::open() {
+    if (is_open_) {
+        log_warn("UDP transport already open");
+        return true;
+    }
+    
+    try {
+        log_info("Opening UDP link to {}:{}", host_, port_);
+        
+        boost::asio::ip::udp::resolver resolver(io_context_);
+        auto endpoints = resolver.resolve(host_, std::to_string(port_));
+        
+        // Connected socket: the kernel filters datagrams from anyone but the peer
+        boost::asio::connect(socket_, endpoints);
+        socket_.non_blocking(true);
+        
+        if (owned_io_context_) {
+            io_context_.restart();
+            io_thread_ = std::thread([this]() {
+                log_debug("UDP I/O thread started");
+                io_context_.run();
+                log_debug("UDP I/O thread stopped");
+            });
+        }
+        
+        startAsyncRead();
+        
+        is_open_ = true;
+        log_info("UDP transport open (local port {})", socket_.local_endpoint().port());
+        return true;
+    
+    } catch (const boost::system::system_error& e) {
+        log_error("Failed to open UDP link: {}", e.what());
+        return false;
+    }
+}
+
+void UdpTransport::close() {
+    if (!is_open_.exchange(false)) {
+        return;
+    }
+    
+    log_info("Closing UDP transport");
+    
+    auto close_socket = [this]() {
+        boost::system::error_code ec;
+        socket_.close(ec);
+        if (ec) {
+            log_error("Error closing UDP socket: {}", ec.message());
+        }
+    };
+    
+    if (owned_io_context_) {
+        close_socket();
+        io_context_.stop();
+        
+        if (io_thread_.joinable()) {
+            io_thread_.join();
+        }
+    } else {
+        // The context keeps running for other transports: wait out our aborted handlers instead
+        runAndDrain(io_context_, close_socket);
+    }
+    
+    write_queue_.clear();
+    
+    log_info("UDP transport closed");
+}
+
+bool UdpTransport::isOpen() const {
+    return is_open_;
+}
+
+void UdpTransport::writeAsync(const PacketCodec::EncodedPacket& packet) {
+    if (!is_open_) {
+        log_warn_limited("Attempted write to closed UDP link");
+        return;
+    }
+    
+    bool start_write = false;
+    if (!write_queue_.push(packet, start_write)) {
+        log_warn_limited("UDP write queue full, dropping {}-byte packet", packet.size);
+        return;
+    }
+    
+    if (start_write) {
+        boost::asio::post(io_context_, [this]() {
+            startWrite();
+        });
+    }
+}
+
+void UdpTransport::setPacketReceivedCallback(PacketReceivedCallback callback) {
+    std::lock_guard<std::mutex> lock(callback_mutex_);
+    packet_callback_ = callback;
+}
+
+std::string UdpTransport::getConnectionInfo() const {
+    return "udp://" + host_ + ":" + std::to_string(port_);
+}
+
+UdpTransport::Stats UdpTransport::getUdpStats() const {
+    Stats stats;
+    stats.datagrams_received = datagrams_received_.load(std::memory_order_relaxed);
+    stats.datagrams_sent = datagrams_sent_.load(std::memory_order_relaxed);
+    stats.receive_calls = receive_calls_.load(std::memory_order_relaxed);
+    stats.send_calls = send_calls_.load(std::memory_order_relaxed);
+    stats.malformed = malformed_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+void UdpTransport::startAsyncRead() {
+    socket_.async_wait(boost::asio::ip::udp::socket::wait_read,
+        [this](const boost::system::error_code& ec) {
+            if (ec) {
+                if (ec != boost::asio::error::operation_aborted) {
+                    log_error("UDP wait error: {}", ec.message());
+                }
+                return;
+            }
+            drainReceived();
+            startAsyncRead();
+        });
+}
+
+void UdpTransport::drainReceived() {
+    // Bounded so a flood cannot starve writes and timers on this thread
+    for (int round = 0; round < 8; ++round) {
+#ifdef __linux__
+        std::array<mmsghdr, BATCH> messages{};
+        std::array<iovec, BATCH> iovecs{};
+        for (size_t i = 0; i < BATCH; ++i) {
+            iovecs[i].iov_base = read_buffers_[i].data();
+            iovecs[i].iov_len = MAX_DATAGRAM_SIZE;
+            messages[i].msg_hdr.msg_iov = &iovecs[i];
+            messages[i].msg_hdr.msg_iovlen = 1;
+        }
+        
+        int received = ::recvmmsg(socket_.native_handle(), messages.data(), BATCH, MSG_DONTWAIT, nullptr);
+        if (received <= 0) {
+            if (received < 0 && errno != EAGAIN && errno != EWOULDBLOCK) {
+                // ECONNREFUSED here just means the peer is not listening (yet)
+                log_debug("UDP receive error: {}", std::strerror(errno));
+            }
+            return;
+        }
+        
+        receive_calls_.fetch_add(1, std::memory_order_relaxed);
+        for (int i = 0; i < received; ++i) {
+            deliverDatagram(read_buffers_[i].data(), messages[i].msg_len,
+                            (messages[i].msg_hdr.msg_flags & MSG_TRUNC) != 0);
+        }
+        if (static_cast<size_t>(received) < BATCH) {
+            return;
+        }
+#else
+        boost::system::error_code ec;
+        size_t bytes = socket_.receive(boost::asio::buffer(read_buffers_[0]), 0, ec);
+        if (ec) {
+            if (ec != boost::asio::error::would_block) {
+                log_debug("UDP receive error: {}", ec.message());
+            }
+            return;
+        }
+        receive_calls_.fetch_add(1, std::memory_order_relaxed);
+        deliverDatagram(read_buffers_[0].data(), bytes, false);
+#endif
+    }
+}
+
+void UdpTransport::deliverDatagram(const uint8_t* data, size_t size, bool truncated) {
+    datagrams_received_.fetch_add(1, std::memory_order_relaxed);
+    if (metrics_) {
+        metrics_->bytes_in.add(size);
+    }
+    
+    // Exactly one packet: [0xAA] [length] [payload], nothing trailing
+    if (truncated || size < 2 || data[0] != PacketCodec::SYNC_BYTE ||
+        data[1] > PacketCodec::MAX_PAYLOAD_SIZE || size != static_cast<size_t>(data[1]) + 2) {
+        malformed_.fetch_add(1, std::memory_order_relaxed);
+        if (metrics_) {
+            metrics_->framing_errors.add();
+        }
+        log_debug("Dropping malformed {}-byte datagram", size);
+        return;
+    }
+    
+    std::lock_guard<std::mutex> lock(callback_mutex_);
+    if (packet_callback_) {
+        packet_callback_(PacketView(data + 2, size - 2));
+    }
+}
+
+void UdpTransport::startWrite() {
+    write_batch_ = write_queue_.beginBatch();
+    continueWrite();
+}
+
+void UdpTransport::continueWrite() {
+    while (!write_batch_.empty()) {
+        boost::system::error_code ec;
+        size_t count = static_cast<size_t>(write_batch_.end() - write_batch_.begin());
+        size_t sent = sendDatagrams(write_batch_.begin(), count, ec);
+        if (metrics_) {
+            for (size_t i = 0; i < sent; ++i) {
+                metrics_->bytes_out.add(write_batch_.first[i].size());
+            }
+        }
+        write_batch_.first += sent;
+        
+        if (ec == boost::asio::error::would_block) {
+            // Socket buffer full: resume the same batch once it drains
+            socket_.async_wait(boost::asio::ip::udp::socket::wait_write,
+                [this](const boost::system::error_code& wait_ec) {
+                    if (wait_ec) {
+                        write_queue_.clear();
+                        return;
+                    }
+                    continueWrite();
+                });
+            return;
+        }
+        if (ec) {
+            // Unreachable peer etc.: the datagram is gone, carry on with the rest
+            log_debug("UDP send error: {}", ec.message());
+            write_batch_.first += 1;
+        }
+    }
+    
+    if (write_queue_.completeBatch()) {
+        startWrite();
+    }
+}
+
+size_t UdpTransport::sendDatagrams(const boost::asio::const_buffer* first, size_t count,
+                                   boost::system::error_code& ec) {
+#ifdef __linux__
+    std::array<mmsghdr, WriteQueue::MAX_BATCH> messages{};
+    std::array<iovec, WriteQueue::MAX_BATCH> iovecs{};
+    for (size_t i = 0; i < count; ++i) {
+        iovecs[i].iov_base = const_cast<void*>(first[i].data());
+        iovecs[i].iov_len = first[i].size();
+        messages[i].msg_hdr.msg_iov = &iovecs[i];
+        messages[i].msg_hdr.msg_iovlen = 1;
+    }
+    
+    int sent = ::sendmmsg(socket_.native_handle(), messages.data(), static_cast<unsigned>(count), MSG_DONTWAIT);
+    if (sent < 0) {
+        ec = (errno == EAGAIN || errno == EWOULDBLOCK)
+            ? boost::asio::error::would_block
+            : boost::system::error_code(errno, boost::system::system_category());
+        return 0;
+    }
+    
+    send_calls_.fetch_add(1, std::memory_order_relaxed);
+    datagrams_sent_.fetch_add(static_cast<uint64_t>(sent), std::memory_order_relaxed);
+    return static_cast<size_t>(sent);
+#else
+    size_t sent = 0;
+    for (; sent < count; ++sent) {
+        socket_.send(boost::asio::buffer(first[sent]), 0, ec);
+        if (ec) {
+            break;
+        }
+        send_calls_.fetch_add(1, std::memory_order_relaxed);
+        datagrams_sent_.fetch_add(1, std::memory_order_relaxed);
+    }
+    return sent;
+#endif
+}
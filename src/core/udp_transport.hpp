@@ -0,0 +1,97 @@
+#ifndef UDP_TRANSPORT_HPP
+#define UDP_TRANSPORT_HPP
+
+#include "core/transport_interface.hpp"
+#include "core/write_queue.hpp"
+#include "core/metrics.hpp"
+#include <boost/asio.hpp>
+#include <thread>
+#include <mutex>
+#include <array>
+#include <atomic>
+#include <memory>
+
+/**
+ * Network (UDP) transport - one framed packet per datagram
+ * 
+ * No retransmission or ordering: a late setpoint is worthless, so a lost
+ * datagram is simply lost. Commands that must arrive go through the
+ * backend's ReliableChannel/PacketAckManager exactly as on TCP.
+ * 
+ * The socket is non-blocking and driven by readiness waits. On Linux each
+ * wake-up drains up to BATCH datagrams with one recvmmsg() and each write
+ * batch goes out with one sendmmsg(); elsewhere the same loops fall back
+ * to a datagram per call.
+ */
+class UdpTransport : public ITransport {
+public:
+    static constexpr size_t BATCH = 32;              // Datagrams per recvmmsg/sendmmsg
+    static constexpr size_t MAX_DATAGRAM_SIZE = 128; // Larger datagrams are truncated and dropped
+    
+    struct Stats {
+        uint64_t datagrams_received = 0;
+        uint64_t datagrams_sent = 0;
+        uint64_t receive_calls = 0;     // recvmmsg (or recv) calls that returned data
+        uint64_t send_calls = 0;
+        uint64_t malformed = 0;         // Not exactly one well-formed packet
+    };
+    
+    /**
+     * @param shared_io_context Run on this (already running) context instead of
+     *        an own I/O thread, e.g. one from an IoContextPool
+     */
+    UdpTransport(const std::string& host, uint16_t port,
+                 boost::asio::io_context* shared_io_context = nullptr);
+    ~UdpTransport() override;
+    
+    bool open() override;
+    void close() override;
+    bool isOpen() const override;
+    void writeAsync(const PacketCodec::EncodedPacket& packet) override;
+    WriteQueue::Stats getWriteStats() const override { return write_queue_.getStats(); }
+    void setPacketReceivedCallback(PacketReceivedCallback callback) override;
+    void setMetrics(LinkMetrics* metrics) override { metrics_ = metrics; }
+    boost::asio::io_context& getIoContext() override { return io_context_; }
+    std::string getConnectionInfo() const override;
+    
+    Stats getUdpStats() const;
+    
+private:
+    void startAsyncRead();
+    void drainReceived();
+    void deliverDatagram(const uint8_t* data, size_t size, bool truncated);
+    void startWrite();
+    void continueWrite();
+    size_t sendDatagrams(const boost::asio::const_buffer* first, size_t count,
+                         boost::system::error_code& ec);
+    
+    std::string host_;
+    uint16_t port_;
+    
+    std::unique_ptr<boost::asio::io_context> owned_io_context_;  // Null when shared
+    boost::asio::io_context& io_context_;
+    boost::asio::ip::udp::socket socket_;
+    boost::asio::executor_work_guard<boost::asio::io_context::executor_type> work_guard_;
+    std::thread io_thread_;     // Only with an owned context
+    
+    // One slot per datagram in a receive batch
+    std::array<std::array<uint8_t, MAX_DATAGRAM_SIZE>, BATCH> read_buffers_;
+    
+    WriteQueue write_queue_;
+    WriteQueue::Batch write_batch_;     // In-flight batch, advanced as datagrams go out
+    
+    PacketReceivedCallback packet_callback_;
+    std::mutex callback_mutex_;
+    
+    LinkMetrics* metrics_;      // Null until setMetrics()
+    
+    std::atomic<uint64_t> datagrams_received_;
+    std::atomic<uint64_t> datagrams_sent_;
+    std::atomic<uint64_t> receive_calls_;
+    std::atomic<uint64_t> send_calls_;
+    std::atomic<uint64_t> malformed_;
+    
+    std::atomic<bool> is_open_;     // Cleared by close() while the I/O thread may be writing
+};
+
+#endif // UDP_TRANSPORT_HPP
@@ -0,0 +1,73 @@
+#include "core/write_queue.hpp"
+#include <algorithm>
+
+bool WriteQueue::push(const PacketCodec::EncodedPacket& packet, bool& start_write) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    start_write = false;
+    if (count_ == CAPACITY) {
+        return false;
+    }
+    
+    slots_[(head_ + count_) % CAPACITY] = packet;
+    count_++;
+    queue_depth_.store(count_, std::memory_order_relaxed);
+    
+    if (!writing_) {
+        writing_ = true;
+        start_write = true;
+    }
+    return true;
+}
+
+WriteQueue::Batch WriteQueue::beginBatch() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    in_flight_ = std::min(count_, MAX_BATCH);
+    
+    size_t bytes = 0;
+    for (size_t i = 0; i < in_flight_; ++i) {
+        const auto& packet = slots_[(head_ + i) % CAPACITY];
+        batch_buffers_[i] = boost::asio::const_buffer(packet.data(), packet.size);
+        bytes += packet.size;
+    }
+    bytes_in_flight_.store(bytes, std::memory_order_relaxed);
+    
+    return Batch{batch_buffers_.data(), batch_buffers_.data() + in_flight_};
+}
+
+bool WriteQueue::completeBatch() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    
+    packets_written_.fetch_add(in_flight_, std::memory_order_relaxed);
+    batches_written_.fetch_add(1, std::memory_order_relaxed);
+    
+    head_ = (head_ + in_flight_) % CAPACITY;
+    count_ -= in_flight_;
+    in_flight_ = 0;
+    
+    queue_depth_.store(count_, std::memory_order_relaxed);
+    bytes_in_flight_.store(0, std::memory_order_relaxed);
+    
+    writing_ = count_ > 0;
+    return writing_;
+}
+
+void WriteQueue::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    head_ = 0;
+    count_ = 0;
+    in_flight_ = 0;
+    writing_ = false;
+    queue_depth_.store(0, std::memory_order_relaxed);
+    bytes_in_flight_.store(0, std::memory_order_relaxed);
+}
+
+WriteQueue::Stats WriteQueue::getStats() const {
+    Stats stats;
+    stats.queue_depth = queue_depth_.load(std::memory_order_relaxed);
+    stats.bytes_in_flight = bytes_in_flight_.load(std::memory_order_relaxed);
+    stats.packets_written = packets_written_.load(std::memory_order_relaxed);
+    stats.batches_written = batches_written_.load(std::memory_order_relaxed);
+    return stats;
+}
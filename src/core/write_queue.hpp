@@ -0,0 +1,91 @@
+#ifndef WRITE_QUEUE_HPP
+#define WRITE_QUEUE_HPP
+
+#include "core/packet_codec.hpp"
+#include <boost/asio/buffer.hpp>
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Fixed-capacity, coalescing outbound packet queue shared by the transports
+ * 
+ * Packets are copied into preallocated slots that stay put until their
+ * write completes, so the slot memory goes straight to asio. Everything
+ * queued while a write is in flight is sent as the next batch in a single
+ * gather write, in order.
+ * 
+ * Producers may be any thread; beginBatch()/completeBatch() are only
+ * called from the transport's I/O thread.
+ */
+class WriteQueue {
+public:
+    static constexpr size_t CAPACITY = 256;
+    static constexpr size_t MAX_BATCH = 64;  // asio's per-call scatter/gather limit
+    
+    /**
+     * Gather buffer sequence over the in-flight batch (asio ConstBufferSequence)
+     */
+    struct Batch {
+        const boost::asio::const_buffer* first = nullptr;
+        const boost::asio::const_buffer* last = nullptr;
+        
+        const boost::asio::const_buffer* begin() const { return first; }
+        const boost::asio::const_buffer* end() const { return last; }
+        bool empty() const { return first == last; }
+    };
+    
+    struct Stats {
+        size_t queue_depth = 0;       // Packets queued, including the in-flight batch
+        size_t bytes_in_flight = 0;   // Bytes handed to the OS but not yet completed
+        uint64_t packets_written = 0;
+        uint64_t batches_written = 0; // One gather write per batch
+    };
+    
+    /**
+     * Queue a packet for writing
+     * @param start_write Set true if no write is in progress and the caller must start one
+     * @return false if the queue is full (packet dropped)
+     */
+    bool push(const PacketCodec::EncodedPacket& packet, bool& start_write);
+    
+    /**
+     * Mark up to MAX_BATCH queued packets as in flight
+     * @return Buffer sequence for one gather write (empty if nothing queued)
+     */
+    Batch beginBatch();
+    
+    /**
+     * Release the in-flight batch once its write has completed
+     * @return true if more packets were queued meanwhile and writing should continue
+     */
+    bool completeBatch();
+    
+    /**
+     * Drop all queued packets (e.g., on close or write error)
+     */
+    void clear();
+    
+    /**
+     * Lock-free counters, safe to read from any thread
+     */
+    Stats getStats() const;
+    
+private:
+    std::mutex mutex_;
+    std::array<PacketCodec::EncodedPacket, CAPACITY> slots_;
+    std::array<boost::asio::const_buffer, MAX_BATCH> batch_buffers_;
+    size_t head_ = 0;
+    size_t count_ = 0;
+    size_t in_flight_ = 0;
+    bool writing_ = false;
+    
+    std::atomic<size_t> queue_depth_{0};
+    std::atomic<size_t> bytes_in_flight_{0};
+    std::atomic<uint64_t> packets_written_{0};
+    std::atomic<uint64_t> batches_written_{0};
+};
+
+#endif // WRITE_QUEUE_HPP
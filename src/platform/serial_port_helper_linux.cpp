@@ -2,6 +2,7 @@
 #include "util/logging.hpp"
 #include <boost/asio/io_context.hpp>
 #include <boost/asio/serial_port.hpp>
+#include <filesystem>
 #include <sstream>
 
 std::vector<std::string> SerialPortHelper::getAvailablePorts() {
@@ -40,6 +41,16 @@ std::vector<std::string> SerialPortHelper::getAvailablePorts() {
         }
     }
     
+    // Simulator PTYs (op-gsim --pty-link /tmp/ttyGIMBAL...)
+    std::error_code ec;
+    for (const auto& entry : std::filesystem::directory_iterator("/tmp", ec)) {
+        std::string name = entry.path().filename().string();
+        if (name.rfind("ttyGIMBAL", 0) == 0 && std::filesystem::exists(entry.path(), ec)) {
+            ports.push_back(entry.path().string());
+            log_debug("Found simulator port: {}", entry.path().string());
+        }
+    }
+    
     if (ports.empty()) {
         log_warn("No serial ports found");
     } else {
@@ -0,0 +1,213 @@
+#include "rendering/plot_decimator.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace Rendering {
+
+PlotDecimator::PlotDecimator() {
+    double width = BASE_BUCKET_S;
+    for (auto& level : levels_) {
+        level.width = width;
+        width *= 2.0;
+    }
+}
+
+void PlotDecimator::clear() {
+    for (auto& level : levels_) {
+        level.buckets.clear();
+        level.head = 0;
+    }
+    raw_ = TelemetryHistory::View{};
+    consumed_ = 0;
+    first_time_ = 0.0;
+    last_time_ = 0.0;
+    out_valid_ = false;
+}
+
+void PlotDecimator::update(const TelemetryHistory& history) {
+    TelemetryHistory::View view = history.getView();
+    
+    if (view.end_index < consumed_) {
+        // History was cleared (disconnect) - start over with it
+        clear();
+    }
+    
+    // Samples older than the view were overwritten before we saw them;
+    // the pyramid just has a gap there
+    uint64_t fresh = std::min<uint64_t>(view.end_index - consumed_, view.count);
+    for (size_t i = view.count - static_cast<size_t>(fresh); i < view.count; ++i) {
+        addSample(view.time[i],
+                  static_cast<float>(view.pan_position[i]),
+                  static_cast<float>(view.pan_setpoint[i]));
+    }
+    
+    raw_ = view;
+    consumed_ = view.end_index;
+}
+
+void PlotDecimator::addSample(double time, float position, float setpoint) {
+    if (levels_[0].buckets.empty()) {
+        first_time_ = time;
+    }
+    last_time_ = time;
+    
+    // Only the newest bucket of each level changes
+    for (auto& level : levels_) {
+        int64_t index = static_cast<int64_t>(std::floor(time / level.width));
+        
+        if (level.buckets.empty() || level.newest().index != index) {
+            Bucket bucket;
+            bucket.index = index;
+            bucket.position_min = bucket.position_max = position;
+            bucket.setpoint_min = bucket.setpoint_max = setpoint;
+            
+            if (level.buckets.size() < LEVEL_CAPACITY) {
+                level.buckets.push_back(bucket);
+            } else {
+                level.buckets[level.head] = bucket;
+                level.head = (level.head + 1) % LEVEL_CAPACITY;
+            }
+            continue;
+        }
+        
+        Bucket& bucket = level.newest();
+        if (position < bucket.position_min) {
+            bucket.position_min = position;
+            bucket.position_min_first = false;
+        } else if (position > bucket.position_max) {
+            bucket.position_max = position;
+            bucket.position_min_first = true;
+        }
+        if (setpoint < bucket.setpoint_min) {
+            bucket.setpoint_min = setpoint;
+            bucket.setpoint_min_first = false;
+        } else if (setpoint > bucket.setpoint_max) {
+            bucket.setpoint_max = setpoint;
+            bucket.setpoint_min_first = true;
+        }
+    }
+}
+
+bool PlotDecimator::getTimeRange(double& first, double& last) const {
+    if (levels_[0].buckets.empty()) {
+        return false;
+    }
+    first = first_time_;
+    last = last_time_;
+    return true;
+}
+
+PlotDecimator::Series PlotDecimator::query(double x_min, double x_max, float pixel_width) {
+    if (x_max <= x_min) {
+        return Series{};
+    }
+    
+    double pixels = std::max(1.0, static_cast<double>(pixel_width));
+    double bucket_width = (x_max - x_min) / pixels;
+    
+    // Close zoom: few enough raw samples on screen to draw them all
+    if (!raw_.empty() && raw_.time[0] <= x_min) {
+        const double* begin = std::lower_bound(raw_.time, raw_.time + raw_.count, x_min);
+        const double* end = std::upper_bound(begin, raw_.time + raw_.count, x_max);
+        if (static_cast<double>(end - begin) <= 2.0 * pixels) {
+            return emitRaw(x_min, x_max);
+        }
+    }
+    
+    // Finest level with a bucket per pixel that still reaches back to x_min
+    size_t chosen = LEVELS - 1;
+    for (size_t i = 0; i < LEVELS; ++i) {
+        const Level& level = levels_[i];
+        if (level.width < bucket_width || level.buckets.empty()) {
+            continue;
+        }
+        if (static_cast<double>(level.at(0).index) * level.width <= x_min) {
+            chosen = i;
+            break;
+        }
+    }
+    
+    return emitLevel(levels_[chosen], x_min, x_max);
+}
+
+PlotDecimator::Series PlotDecimator::emitRaw(double x_min, double x_max) {
+    const double* time_end = raw_.time + raw_.count;
+    
+    // One sample either side so the line runs to the plot edges
+    size_t first = static_cast<size_t>(std::lower_bound(raw_.time, time_end, x_min) - raw_.time);
+    size_t last = static_cast<size_t>(std::upper_bound(raw_.time, time_end, x_max) - raw_.time);
+    first = first > 0 ? first - 1 : 0;
+    last = std::min(last + 1, raw_.count);
+    
+    Series series;
+    series.time = raw_.time + first;
+    series.pan_position = raw_.pan_position + first;
+    series.pan_setpoint = raw_.pan_setpoint + first;
+    series.count = static_cast<int>(last - first);
+    return series;
+}
+
+PlotDecimator::Series PlotDecimator::emitLevel(const Level& level, double x_min, double x_max) {
+    Series series;
+    series.decimated = true;
+    
+    int64_t first_index = static_cast<int64_t>(std::floor(x_min / level.width)) - 1;
+    int64_t last_index = static_cast<int64_t>(std::floor(x_max / level.width)) + 1;
+    size_t level_number = static_cast<size_t>(&level - levels_.data());
+    
+    // Same zoom, same range, no new samples: last frame's points still hold
+    bool cached = out_valid_
+        && out_level_ == level_number
+        && out_first_ == first_index
+        && out_last_ == last_index
+        && out_consumed_ == consumed_;
+    
+    if (!cached) {
+        out_time_.clear();
+        out_position_.clear();
+        out_setpoint_.clear();
+        
+        // Buckets are in index order, so binary search the ring
+        size_t lo = 0;
+        size_t hi = level.size();
+        while (lo < hi) {
+            size_t mid = lo + (hi - lo) / 2;
+            if (level.at(mid).index < first_index) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        
+        for (size_t i = lo; i < level.size(); ++i) {
+            const Bucket& bucket = level.at(i);
+            if (bucket.index > last_index) {
+                break;
+            }
+            
+            // Both extremes, in the order they happened
+            double start = static_cast<double>(bucket.index) * level.width;
+            out_time_.push_back(start + level.width * 0.25);
+            out_time_.push_back(start + level.width * 0.75);
+            
+            out_position_.push_back(bucket.position_min_first ? bucket.position_min : bucket.position_max);
+            out_position_.push_back(bucket.position_min_first ? bucket.position_max : bucket.position_min);
+            out_setpoint_.push_back(bucket.setpoint_min_first ? bucket.setpoint_min : bucket.setpoint_max);
+            out_setpoint_.push_back(bucket.setpoint_min_first ? bucket.setpoint_max : bucket.setpoint_min);
+        }
+        
+        out_valid_ = true;
+        out_level_ = level_number;
+        out_first_ = first_index;
+        out_last_ = last_index;
+        out_consumed_ = consumed_;
+    }
+    
+    series.time = out_time_.data();
+    series.pan_position = out_position_.data();
+    series.pan_setpoint = out_setpoint_.data();
+    series.count = static_cast<int>(out_time_.size());
+    return series;
+}
+
+} // namespace Rendering
@@ -0,0 +1,111 @@
+#ifndef PLOT_DECIMATOR_HPP
+#define PLOT_DECIMATOR_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "core/telemetry_history.hpp"
+
+namespace Rendering {
+
+/**
+ * Min/max decimation of the telemetry history for plotting
+ * 
+ * Samples are folded into a pyramid of min/max buckets aligned to an
+ * absolute time grid, one level per zoom step (1 ms, 2 ms, 4 ms, ...).
+ * Each level is a cache of that zoom and is updated incrementally: a new
+ * sample only touches the open (newest) bucket of every level, so the
+ * pyramid keeps hours of data long after the raw history has wrapped.
+ * 
+ * A query picks the finest level with at least one bucket per pixel and
+ * emits each bucket's min and max in the order they occurred, so spikes
+ * and the envelope of the signal survive at any zoom. When the visible
+ * range holds few enough raw samples, those are plotted directly.
+ * 
+ * GUI thread only.
+ */
+class PlotDecimator {
+public:
+    static constexpr size_t LEVELS = 16;                     // 1 ms .. ~33 s buckets
+    static constexpr size_t LEVEL_CAPACITY = size_t(1) << 14;
+    static constexpr double BASE_BUCKET_S = 0.001;
+    
+    /**
+     * Series ready for ImPlot::PlotLine (valid until the next update/query)
+     */
+    struct Series {
+        const double* time = nullptr;
+        const double* pan_position = nullptr;
+        const double* pan_setpoint = nullptr;
+        int count = 0;
+        bool decimated = false;
+    };
+    
+    PlotDecimator();
+    
+    /**
+     * Fold in samples appended to the history since the last call
+     */
+    void update(const TelemetryHistory& history);
+    
+    /**
+     * Points covering [x_min, x_max] at roughly one bucket per pixel
+     */
+    Series query(double x_min, double x_max, float pixel_width);
+    
+    /**
+     * Time span held by the pyramid (false while empty)
+     */
+    bool getTimeRange(double& first, double& last) const;
+    
+    void clear();
+    
+private:
+    struct Bucket {
+        int64_t index = 0;          // Start time / bucket width
+        float position_min = 0.0f;
+        float position_max = 0.0f;
+        float setpoint_min = 0.0f;
+        float setpoint_max = 0.0f;
+        bool position_min_first = true;
+        bool setpoint_min_first = true;
+    };
+    
+    // Buckets in time order, oldest evicted once LEVEL_CAPACITY is reached
+    struct Level {
+        double width = 0.0;
+        std::vector<Bucket> buckets;
+        size_t head = 0;            // Oldest bucket once the ring is full
+        
+        size_t size() const { return buckets.size(); }
+        const Bucket& at(size_t i) const { return buckets[(head + i) % buckets.size()]; }
+        Bucket& newest() { return buckets[(head + buckets.size() - 1) % buckets.size()]; }
+    };
+    
+    void addSample(double time, float position, float setpoint);
+    Series emitRaw(double x_min, double x_max);
+    Series emitLevel(const Level& level, double x_min, double x_max);
+    
+    std::array<Level, LEVELS> levels_;
+    
+    // Raw samples of the latest history view, kept for close zooms
+    TelemetryHistory::View raw_;
+    uint64_t consumed_ = 0;
+    double first_time_ = 0.0;
+    double last_time_ = 0.0;
+    
+    // Output reused across frames, and the query it currently answers
+    std::vector<double> out_time_;
+    std::vector<double> out_position_;
+    std::vector<double> out_setpoint_;
+    bool out_valid_ = false;
+    size_t out_level_ = 0;
+    int64_t out_first_ = 0;
+    int64_t out_last_ = 0;
+    uint64_t out_consumed_ = 0;
+};
+
+} // namespace Rendering
+
+#endif // PLOT_DECIMATOR_HPP
@@ -0,0 +1,94 @@
+#include "rendering/render_scheduler.hpp"
+#include "util/logging.hpp"
+#include <GLFW/glfw3.h>
+#include <algorithm>
+#include <thread>
+
+namespace Rendering {
+
+namespace {
+    std::chrono::steady_clock::duration frameInterval(double fps) {
+        return std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(1.0 / fps));
+    }
+}
+
+RenderScheduler::RenderScheduler()
+    : RenderScheduler(Config{}) {
+}
+
+RenderScheduler::RenderScheduler(const Config& config)
+    : wake_interval_(Clock::duration::zero())
+    , last_frame_()
+    , settle_frames_left_(0)
+    , redraw_requested_(true) {
+    setConfig(config);
+}
+
+void RenderScheduler::setConfig(const Config& config) {
+    config_ = config;
+    config_.max_fps = std::clamp(config_.max_fps, 0.1, 1000.0);
+    config_.min_fps = std::clamp(config_.min_fps, 0.1, config_.max_fps);
+    config_.settle_frames = std::max(config_.settle_frames, 0);
+    
+    min_interval_ = frameInterval(config_.max_fps);
+    max_interval_ = frameInterval(config_.min_fps);
+    
+    log_info("Frame rate: {:.1f} fps max, {:.1f} fps idle", config_.max_fps, config_.min_fps);
+}
+
+void RenderScheduler::setWakeInterval(Clock::duration interval) {
+    wake_interval_ = std::max(interval, Clock::duration::zero());
+}
+
+void RenderScheduler::requestRedraw() {
+    // Telemetry can ask a thousand times a second: only the first request
+    // since the last frame started pays for posting a wake-up
+    if (!redraw_requested_.exchange(true, std::memory_order_acq_rel)) {
+        glfwPostEmptyEvent();
+    }
+}
+
+bool RenderScheduler::waitForNextFrame(GLFWwindow* window) {
+    Clock::duration idle_interval = wake_interval_ > Clock::duration::zero()
+        ? std::min(max_interval_, wake_interval_)
+        : max_interval_;
+    
+    if (glfwGetWindowAttrib(window, GLFW_ICONIFIED)) {
+        // Nothing visible: keep handling events, draw once restored
+        glfwWaitEventsTimeout(std::chrono::duration<double>(idle_interval).count());
+        redraw_requested_.store(false, std::memory_order_release);
+        settle_frames_left_ = config_.settle_frames;
+        return false;
+    }
+    
+    Clock::time_point deadline = last_frame_ + idle_interval;
+    if (settle_frames_left_ == 0 && !redraw_requested_.load(std::memory_order_acquire)) {
+        Clock::time_point now = Clock::now();
+        if (now < deadline) {
+            glfwWaitEventsTimeout(std::chrono::duration<double>(deadline - now).count());
+            
+            // Woken early and not by requestRedraw(): that was input
+            if (!redraw_requested_.load(std::memory_order_acquire) && Clock::now() < deadline) {
+                settle_frames_left_ = config_.settle_frames;
+            }
+        }
+    }
+    
+    // Cap the rate whatever woke us, then collect input that came meanwhile
+    Clock::time_point earliest = last_frame_ + min_interval_;
+    if (Clock::now() < earliest) {
+        std::this_thread::sleep_until(earliest);
+    }
+    glfwPollEvents();
+    
+    // Cleared before drawing, so data arriving during the frame asks for another
+    redraw_requested_.store(false, std::memory_order_release);
+    if (settle_frames_left_ > 0) {
+        --settle_frames_left_;
+    }
+    last_frame_ = Clock::now();
+    return true;
+}
+
+} // namespace Rendering
@@ -0,0 +1,76 @@
+#ifndef RENDER_SCHEDULER_HPP
+#define RENDER_SCHEDULER_HPP
+
+#include <atomic>
+#include <chrono>
+
+struct GLFWwindow;
+
+namespace Rendering {
+
+/**
+ * Decides when the main loop draws a frame
+ * 
+ * Instead of polling and redrawing flat out, the loop sleeps in
+ * glfwWaitEventsTimeout() until something can change the picture: window
+ * input, new data (requestRedraw(), e.g. from the I/O thread on telemetry
+ * or an ack) or the idle deadline of min_fps, which keeps slow-changing
+ * text such as connection state current. Frames never come faster than
+ * max_fps, however often they are requested.
+ * 
+ * After input a few more frames are drawn (settle_frames): ImGui reacts to
+ * a click or key over more than one frame.
+ */
+class RenderScheduler {
+public:
+    struct Config {
+        double max_fps = 60.0;      // Upper bound (vsync may cap it lower)
+        double min_fps = 2.0;       // Redraw at least this often when idle
+        int settle_frames = 3;      // Frames drawn after input
+    };
+    
+    RenderScheduler();
+    explicit RenderScheduler(const Config& config);
+    
+    /**
+     * GUI thread. Rates are clamped to 0.1 .. 1000 fps, min_fps to max_fps.
+     */
+    void setConfig(const Config& config);
+    const Config& getConfig() const { return config_; }
+    
+    /**
+     * GUI thread. Longest waitForNextFrame() may sleep, idle or minimised,
+     * for work done once per loop pass (e.g. metrics sampling); tightens
+     * min_fps only. Zero = no limit.
+     */
+    void setWakeInterval(std::chrono::steady_clock::duration interval);
+    
+    /**
+     * Ask for a frame (any thread). Wakes the GUI thread if it is waiting;
+     * requests made before that frame starts share one wake-up.
+     */
+    void requestRedraw();
+    
+    /**
+     * GUI thread, at the top of the loop: handles window events until it
+     * is time to draw.
+     * @return false if there is nothing to draw (window minimised)
+     */
+    bool waitForNextFrame(GLFWwindow* window);
+    
+private:
+    using Clock = std::chrono::steady_clock;
+    
+    Config config_;
+    Clock::duration min_interval_;      // 1 / max_fps
+    Clock::duration max_interval_;      // 1 / min_fps
+    Clock::duration wake_interval_;     // Cap on any wait, zero = none
+    Clock::time_point last_frame_;
+    int settle_frames_left_;
+    
+    std::atomic<bool> redraw_requested_;
+};
+
+} // namespace Rendering
+
+#endif // RENDER_SCHEDULER_HPP
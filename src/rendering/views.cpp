@@ -1,25 +1,65 @@
+#include <algorithm>
 #include <memory>
+#include <string>
 #include "rendering/views.hpp"
 #include "rendering/views/gimbal_control_view.hpp"
+#include "rendering/views/diagnostics_view.hpp"
 #include "util/logging.hpp"
 #include "util/events.hpp"
+#include "imgui.h"
 
 namespace Rendering {
 
-ViewManager::ViewManager(GimbalState& gimbal_state, CommunicationBackend& comm_backend)
-    : gimbal_state_(gimbal_state)
-    , comm_backend_(comm_backend) {
+namespace {
+    // Short link status for the device selector
+    void deviceStatus(const CommunicationBackend& backend, const char*& text, ImVec4& color) {
+        if (backend.isConnected()) {
+            text = "connected";
+            color = ImVec4(0.0f, 1.0f, 0.0f, 1.0f);
+        } else if (backend.isReconnecting()) {
+            text = "reconnecting";
+            color = ImVec4(1.0f, 0.5f, 0.0f, 1.0f);
+        } else if (backend.isConnecting()) {
+            text = "connecting";
+            color = ImVec4(1.0f, 1.0f, 0.0f, 1.0f);
+        } else {
+            text = "disconnected";
+            color = ImVec4(0.5f, 0.5f, 0.5f, 1.0f);
+        }
+    }
+}
+
+ViewManager::ViewManager(DeviceManager& devices)
+    : devices_(devices) {
     log_debug("ViewManager created");
     
-    // Set initial view
-    setView(std::make_shared<GimbalControlView>(gimbal_state_, comm_backend_));
+    // One view per device that already exists, then show the first
+    for (size_t i = 0; i < devices_.getDeviceCount(); ++i) {
+        device_views_.push_back(makeDeviceViews(i));
+        next_device_number_++;
+    }
+    if (devices_.getDeviceCount() == 0) {
+        addDevice();
+    }
+    selectDevice(0);
     
     // Subscribe to view change events
-    Events::EventQueue::getInstance().subscribe("views/set_view", [this](const Events::Event& event) {
-        if (auto* setViewEvent = dynamic_cast<const Events::SetViewEvent*>(&event)) {
-            setView(setViewEvent->getView());
-        }
-    });
+    set_view_subscription_ = Events::EventBus::getInstance().subscribe<Events::SetViewEvent>(
+        [this](const Events::SetViewEvent& event) {
+            setView(event.view);
+        });
+    
+    // The backend only knows its link, the device name lives here
+    link_subscription_ = Events::EventBus::getInstance().subscribe<Events::LinkEvent>(
+        [this](const Events::LinkEvent& event) {
+            for (size_t i = 0; i < devices_.getDeviceCount(); ++i) {
+                auto& device = devices_.getDevice(i);
+                if (device.backend.get() == event.source) {
+                    log_info("{}: link {}", device.name,
+                             event.kind == Events::LinkEvent::Kind::Lost ? "lost" : "recovered");
+                }
+            }
+        });
     
     log_debug("View change listener subscribed");
 }
@@ -27,15 +67,121 @@ ViewManager::ViewManager(GimbalState& gimbal_state, CommunicationBackend& comm_b
 ViewManager::~ViewManager() {
     log_debug("ViewManager destructor - unsubscribing from events");
     // Unsubscribe from events to prevent dangling references
-    Events::EventQueue::getInstance().unsubscribe("views/set_view");
+    Events::EventBus::getInstance().unsubscribe(set_view_subscription_);
+    Events::EventBus::getInstance().unsubscribe(link_subscription_);
 }
 
 void ViewManager::setView(std::shared_ptr<View> view) {
     log_info("Changing view");
+    
+    // Remember which page of the selected device this is
+    if (selected_device_ < device_views_.size()) {
+        const DeviceViews& views = device_views_[selected_device_];
+        if (view == views.diagnostics) {
+            show_diagnostics_ = true;
+        } else if (view == views.control) {
+            show_diagnostics_ = false;
+        }
+    }
     current_view_ = std::move(view);
 }
 
+ViewManager::DeviceViews ViewManager::makeDeviceViews(size_t index) {
+    auto& device = devices_.getDevice(index);
+    DeviceViews views;
+    views.control = std::make_shared<GimbalControlView>(*device.state, *device.backend);
+    views.diagnostics = std::make_shared<DiagnosticsView>(*device.backend);
+    return views;
+}
+
+void ViewManager::addDevice() {
+    size_t index = devices_.addDevice("Gimbal " + std::to_string(next_device_number_++));
+    device_views_.push_back(makeDeviceViews(index));
+}
+
+void ViewManager::removeDevice(size_t index) {
+    // The views hold references into the device: drop them first
+    const DeviceViews& views = device_views_[index];
+    if (current_view_ == views.control || current_view_ == views.diagnostics) {
+        current_view_.reset();
+    }
+    device_views_.erase(device_views_.begin() + static_cast<std::ptrdiff_t>(index));
+    devices_.removeDevice(index);
+    
+    if (device_views_.empty()) {
+        addDevice();
+    }
+    selectDevice(std::min(selected_device_, device_views_.size() - 1));
+}
+
+void ViewManager::selectDevice(size_t index) {
+    selected_device_ = index;
+    setView(show_diagnostics_ ? device_views_[index].diagnostics : device_views_[index].control);
+}
+
+void ViewManager::renderDeviceSelector() {
+    if (!ImGui::BeginMainMenuBar()) {
+        return;
+    }
+    
+    size_t remove_index = device_views_.size();
+    
+    if (ImGui::BeginMenu("Devices")) {
+        if (ImGui::MenuItem("Add Device")) {
+            addDevice();
+            selectDevice(device_views_.size() - 1);
+        }
+        if (ImGui::MenuItem("Remove Selected", nullptr, false, devices_.getDeviceCount() > 1)) {
+            remove_index = selected_device_;
+        }
+        ImGui::Separator();
+        ImGui::TextDisabled("%zu I/O threads shared by %zu devices",
+                            devices_.getPool().size(), devices_.getDeviceCount());
+        ImGui::EndMenu();
+    }
+    
+    if (ImGui::BeginMenu("View")) {
+        const DeviceViews& views = device_views_[selected_device_];
+        if (ImGui::MenuItem("Control", nullptr, !show_diagnostics_)) {
+            Events::EventBus::getInstance().post(Events::SetViewEvent{views.control});
+        }
+        if (ImGui::MenuItem("Diagnostics", nullptr, show_diagnostics_)) {
+            Events::EventBus::getInstance().post(Events::SetViewEvent{views.diagnostics});
+        }
+        ImGui::EndMenu();
+    }
+    
+    // One entry per device, with its link status at a glance
+    for (size_t i = 0; i < devices_.getDeviceCount(); ++i) {
+        auto& device = devices_.getDevice(i);
+        const char* status;
+        ImVec4 color;
+        deviceStatus(*device.backend, status, color);
+        
+        ImGui::PushID(static_cast<int>(i));
+        ImGui::PushStyleColor(ImGuiCol_Text, color);
+        ImGui::Bullet();
+        ImGui::PopStyleColor();
+        if (ImGui::MenuItem(device.name.c_str(), nullptr, i == selected_device_)) {
+            selectDevice(i);
+        }
+        if (ImGui::IsItemHovered()) {
+            ImGui::SetTooltip("%s: %s", device.backend->getConnectionInfo().c_str(), status);
+        }
+        ImGui::PopID();
+    }
+    
+    ImGui::EndMainMenuBar();
+    
+    // After the bar is closed: removal destroys the device's view
+    if (remove_index < device_views_.size()) {
+        removeDevice(remove_index);
+    }
+}
+
 void ViewManager::render() {
+    renderDeviceSelector();
+    
     if (current_view_) {
         current_view_->render();
     }
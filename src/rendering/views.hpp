@@ -2,8 +2,9 @@
 #define VIEWS_HPP
 
 #include <memory>
-#include "core/gimbal_state.hpp"
-#include "core/communication_backend.hpp"
+#include <vector>
+#include "core/device_manager.hpp"
+#include "util/events.hpp"
 
 namespace Rendering {
 
@@ -16,17 +17,41 @@ public:
     virtual void render() = 0;
 };
 
+/**
+ * Renders the device selector (main menu bar) and the selected device's view
+ * 
+ * Each device keeps its own views, so switching devices keeps each one's
+ * connection form, plot and streaming state. The View menu switches the
+ * selected device between its control and diagnostics pages (through a
+ * SetViewEvent); the page sticks when switching devices.
+ */
 class ViewManager {
 public:
-    ViewManager(GimbalState& gimbal_state, CommunicationBackend& comm_backend);
+    explicit ViewManager(DeviceManager& devices);
     ~ViewManager();
     void render();
     void setView(std::shared_ptr<View> view);
     
 private:
+    void renderDeviceSelector();
+    void addDevice();
+    void removeDevice(size_t index);
+    void selectDevice(size_t index);
+    
+    struct DeviceViews {
+        std::shared_ptr<View> control;
+        std::shared_ptr<View> diagnostics;
+    };
+    DeviceViews makeDeviceViews(size_t index);
+    
     std::shared_ptr<View> current_view_;
-    GimbalState& gimbal_state_;
-    CommunicationBackend& comm_backend_;
+    DeviceManager& devices_;
+    std::vector<DeviceViews> device_views_;     // Parallel to the device list
+    size_t selected_device_ = 0;
+    bool show_diagnostics_ = false;
+    Events::EventBus::SubscriptionId set_view_subscription_ = 0;
+    Events::EventBus::SubscriptionId link_subscription_ = 0;
+    int next_device_number_ = 1;
 };
 
 } // namespace Rendering
@@ -0,0 +1,88 @@
+#include "rendering/views/diagnostics_view.hpp"
+#include "core/metrics.hpp"
+#include "util/logging.hpp"
+#include "imgui.h"
+#include <algorithm>
+#include <chrono>
+
+namespace Rendering {
+
+DiagnosticsView::DiagnosticsView(CommunicationBackend& comm_backend)
+    : comm_backend_(comm_backend) {
+    log_debug("DiagnosticsView created");
+}
+
+void DiagnosticsView::render() {
+    ImGuiViewport* viewport = ImGui::GetMainViewport();
+    ImGui::SetNextWindowPos(viewport->WorkPos);
+    ImGui::SetNextWindowSize(viewport->WorkSize);
+    
+    ImGuiWindowFlags flags = ImGuiWindowFlags_NoDecoration |
+                             ImGuiWindowFlags_NoMove |
+                             ImGuiWindowFlags_NoResize |
+                             ImGuiWindowFlags_NoBringToFrontOnFocus;
+    
+    ImGui::Begin("DiagnosticsView", nullptr, flags);
+    
+    auto& comm = comm_backend_;
+    const MetricsRegistry& metrics = comm.getMetrics();
+    
+    ImGui::SeparatorText("Link Diagnostics");
+    ImGui::Text("%s", comm.getConnectionInfo().c_str());
+    
+    constexpr double history_s = MetricsRegistry::HISTORY *
+        std::chrono::duration<double>(MetricsRegistry::SAMPLE_INTERVAL).count();
+    ImGui::TextDisabled("Cumulative across connections; plots cover the last %.0f s", history_s);
+    ImGui::Spacing();
+    
+    ImGuiTableFlags table_flags = ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerH;
+    if (ImGui::BeginTable("Metrics", 3, table_flags)) {
+        ImGui::TableSetupColumn("Metric", ImGuiTableColumnFlags_WidthFixed, 160.0f);
+        ImGui::TableSetupColumn("Value", ImGuiTableColumnFlags_WidthFixed, 220.0f);
+        ImGui::TableSetupColumn("History", ImGuiTableColumnFlags_WidthStretch);
+        ImGui::TableHeadersRow();
+        
+        for (size_t i = 0; i < metrics.size(); ++i) {
+            MetricsRegistry::Series series = metrics.getSeries(i);
+            
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::AlignTextToFramePadding();
+            ImGui::TextUnformatted(series.name);
+            
+            ImGui::TableNextColumn();
+            switch (series.kind) {
+                case MetricsRegistry::Kind::Rate:
+                    ImGui::Text("%.0f %s", series.current, series.unit);
+                    ImGui::SameLine();
+                    ImGui::TextDisabled("(%.0f total)", series.total);
+                    break;
+                
+                case MetricsRegistry::Kind::Counter:
+                    ImGui::Text("%.0f %s", series.total, series.unit);
+                    break;
+                
+                case MetricsRegistry::Kind::Gauge:
+                    ImGui::Text("%.1f %s", series.total, series.unit);
+                    ImGui::SameLine();
+                    ImGui::TextDisabled("(peak %.1f)", series.peak);
+                    break;
+            }
+            
+            ImGui::TableNextColumn();
+            ImGui::PushID(static_cast<int>(i));
+            // Scaled from 0 so a quiet link draws a flat line, not magnified noise
+            float scale_max = std::max(1.0f, static_cast<float>(series.peak) * 1.1f);
+            ImGui::PlotLines("##history", series.history, static_cast<int>(series.count),
+                             static_cast<int>(series.offset), nullptr, 0.0f, scale_max,
+                             ImVec2(-1.0f, 32.0f));
+            ImGui::PopID();
+        }
+        
+        ImGui::EndTable();
+    }
+    
+    ImGui::End();
+}
+
+} // namespace Rendering
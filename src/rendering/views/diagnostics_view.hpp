@@ -0,0 +1,27 @@
+#ifndef DIAGNOSTICS_VIEW_HPP
+#define DIAGNOSTICS_VIEW_HPP
+
+#include "rendering/views.hpp"
+#include "core/communication_backend.hpp"
+
+namespace Rendering {
+
+/**
+ * Live link metrics of one device: current value and a sparkline of the
+ * sampled history for every metric the backend registers
+ * 
+ * Only reads the backend's MetricsRegistry; sampling is driven by the
+ * ViewManager so the history keeps filling while this view is hidden.
+ */
+class DiagnosticsView : public View {
+public:
+    explicit DiagnosticsView(CommunicationBackend& comm_backend);
+    void render() override;
+    
+private:
+    CommunicationBackend& comm_backend_;
+};
+
+} // namespace Rendering
+
+#endif // DIAGNOSTICS_VIEW_HPP
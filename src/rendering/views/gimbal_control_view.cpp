@@ -7,8 +7,12 @@
 #include "implot.h"
 #include <utility>
 #include <vector>
+#include <algorithm>
 #include <cmath>
 #include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
 
 namespace Rendering {
 
@@ -19,6 +23,42 @@ GimbalControlView::GimbalControlView(GimbalState& gimbal_state, CommunicationBac
     , comm_backend_(comm_backend) {
     log_debug("GimbalControlView created");
     refreshSerialPorts();
+    
+    command_subscription_ = Events::EventBus::getInstance().subscribe<Events::CommandEvent>(
+        [this](const Events::CommandEvent& event) {
+            if (event.source == &comm_backend_) {
+                last_command_ = event.name;
+                last_command_acked_ = event.success;
+            }
+        });
+}
+
+GimbalControlView::~GimbalControlView() {
+    Events::EventBus::getInstance().unsubscribe(command_subscription_);
+}
+
+std::string GimbalControlView::makeRecordingPath() {
+    std::time_t now = std::time(nullptr);
+    char name[64];
+    std::strftime(name, sizeof(name), "recordings/session_%Y%m%d_%H%M%S.oprec", std::localtime(&now));
+    return name;
+}
+
+bool GimbalControlView::exportLatencyReport(const std::string& json) {
+    std::time_t now = std::time(nullptr);
+    char name[64];
+    std::strftime(name, sizeof(name), "recordings/latency_%Y%m%d_%H%M%S.json", std::localtime(&now));
+    
+    std::error_code ec;
+    std::filesystem::create_directories("recordings", ec);
+    std::ofstream file(name);
+    file << json;
+    if (!file) {
+        log_error("Failed to write latency report {}", name);
+        return false;
+    }
+    log_info("Wrote latency report {}", name);
+    return true;
 }
 
 void GimbalControlView::refreshSerialPorts() {
@@ -46,7 +86,9 @@ void GimbalControlView::render() {
     
     // Use references instead of getInstance()
     auto& comm = comm_backend_;
-    auto& gimbal = gimbal_state_;
+    
+    // One lock-free read of the whole gimbal state per frame
+    const GimbalState::Snapshot gimbal = gimbal_state_.getSnapshot();
     
     ImVec2 avail = ImGui::GetContentRegionAvail();
     
@@ -58,29 +100,35 @@ void GimbalControlView::render() {
     float middle_height = 200.0f;
     float bottom_height = avail.y - top_height - middle_height - 20.0f;
     
-    static TransType connection_type = TransType::Serial;
-    
     // ═══════════════════════════════════════
     // TOP LEFT: Connection Panel
     // ═══════════════════════════════════════
     ImGui::BeginChild("ConnectionPanel", ImVec2(left_panel_width, top_height), true);
     {
         ImGui::SeparatorText("Connection");
-
+        
         ImGui::Text("Status:");
         ImGui::SameLine();
         
+        bool is_reconnecting = comm.isReconnecting();
+        bool is_connecting = comm.isConnecting() || is_reconnecting;
+        auto link_stats = comm.getLinkStats();
+        
         if (comm.isConnected()) {
             ImGui::TextColored(ImVec4(0.0f, 1.0f, 0.0f, 1.0f), "Connected");
             ImGui::SameLine();
             ImGui::Text("to %s", comm.getConnectionInfo().c_str());
+        } else if (is_reconnecting) {
+            ImGui::TextColored(ImVec4(1.0f, 0.5f, 0.0f, 1.0f), "Reconnecting...");
+            ImGui::SameLine();
+            ImGui::Text("attempt %u", link_stats.attempt);
+            ImGui::TextWrapped("%s", link_stats.last_loss_reason.c_str());
+        } else if (is_connecting) {
+            ImGui::TextColored(ImVec4(1.0f, 1.0f, 0.0f, 1.0f), "Connecting...");
+            ImGui::SameLine();
+            ImGui::Text("to %s", comm.getConnectionInfo().c_str());
         } else {
-            auto transport_type = comm.getTransportType();
-            if (transport_type != TransType::None) {
-                ImGui::TextColored(ImVec4(1.0f, 1.0f, 0.0f, 1.0f), "Connecting...");
-            } else {
-                ImGui::TextColored(ImVec4(0.5f, 0.5f, 0.5f, 1.0f), "Disconnected");
-            }
+            ImGui::TextColored(ImVec4(0.5f, 0.5f, 0.5f, 1.0f), "Disconnected");
             
             auto error = comm.getErrorMessage();
             if (!error.empty()) {
@@ -94,21 +142,25 @@ void GimbalControlView::render() {
         
         bool is_connected = comm.isConnected();
         
-        ImGui::BeginDisabled(is_connected);
+        ImGui::BeginDisabled(is_connected || is_connecting);
         {
-            int connection_type_int = static_cast<int>(connection_type);
+            int connection_type_int = static_cast<int>(connection_type_);
             
             if (ImGui::RadioButton("Serial", &connection_type_int, static_cast<int>(TransType::Serial))) {
-                connection_type = TransType::Serial;
+                connection_type_ = TransType::Serial;
             }
             ImGui::SameLine();
             if (ImGui::RadioButton("Network", &connection_type_int, static_cast<int>(TransType::Network))) {
-                connection_type = TransType::Network;
+                connection_type_ = TransType::Network;
+            }
+            ImGui::SameLine();
+            if (ImGui::RadioButton("Replay", &connection_type_int, static_cast<int>(TransType::Replay))) {
+                connection_type_ = TransType::Replay;
             }
             
             ImGui::Spacing();
             
-            if (connection_type == TransType::Serial) {
+            if (connection_type_ == TransType::Serial) {
                 static const std::pair<const char*, int> baud_rate_options[] = {
                     {"9600", 9600},
                     {"19200", 19200},
@@ -119,13 +171,12 @@ void GimbalControlView::render() {
                     {"460800", 460800},
                     {"921600", 921600}
                 };
-                static int baud_rate_index = 4;
                 
                 float combo_width = ImGui::GetContentRegionAvail().x;
                 float label_width = 80.0f;
                 float refresh_button_width = 55.0f;
                 float spacing = ImGui::GetStyle().ItemSpacing.x;
-
+                
                 // Port dropdown + refresh button
                 ImGui::SetNextItemWidth(combo_width - refresh_button_width - label_width - spacing * 2);
                 const char* current_port = available_serial_ports_[selected_port_index_].c_str();
@@ -141,7 +192,7 @@ void GimbalControlView::render() {
                     }
                     ImGui::EndCombo();
                 }
-
+                
                 ImGui::SameLine();
                 if (ImGui::Button("Refresh", ImVec2(refresh_button_width, 0))) {
                     log_info("Refreshing serial port list");
@@ -150,23 +201,23 @@ void GimbalControlView::render() {
                 if (ImGui::IsItemHovered()) {
                     ImGui::SetTooltip("Refresh serial port list");
                 }
-
+                
                 ImGui::SameLine();
                 ImGui::Text("Port");
-
+                
                 // Baud rate dropdown
                 ImGui::SetNextItemWidth(combo_width - label_width - spacing);
-                if (ImGui::BeginCombo("##BaudRate", baud_rate_options[baud_rate_index].first)) {
+                if (ImGui::BeginCombo("##BaudRate", baud_rate_options[baud_rate_index_].first)) {
                     for (int n = 0; n < IM_ARRAYSIZE(baud_rate_options); n++) {
-                        const bool is_selected = (baud_rate_index == n);
+                        const bool is_selected = (baud_rate_index_ == n);
                         if (ImGui::Selectable(baud_rate_options[n].first, is_selected)) {
-                            baud_rate_index = n;
+                            baud_rate_index_ = n;
                         }
                         if (is_selected) ImGui::SetItemDefaultFocus();
                     }
                     ImGui::EndCombo();
                 }
-
+                
                 ImGui::SameLine();
                 ImGui::Text("Baud Rate");
                 
@@ -176,34 +227,97 @@ void GimbalControlView::render() {
                     if (selected_port == "No ports found") {
                         log_error("No serial ports available");
                     } else {
-                        int baud_rate = baud_rate_options[baud_rate_index].second;
+                        int baud_rate = baud_rate_options[baud_rate_index_].second;
                         log_info("Connecting to serial: {} @ {}", selected_port, baud_rate);
                         comm.connectSerial(selected_port, baud_rate);
                     }
                 }
+            
+            } else if (connection_type_ == TransType::Network) {
+                static const SocketProfile profile_options[] = {
+                    SocketProfile::lowLatency(),
+                    SocketProfile::busyPoll(),
+                    SocketProfile::osDefault()
+                };
                 
-            } else if (connection_type == TransType::Network) {
-                static char ip_buffer[128] = "192.168.1.100";
-                static int port = 3883;
+                ImGui::InputText("IP Address", ip_buffer_, sizeof(ip_buffer_));
+                ImGui::InputInt("Port", &network_port_);
+                ImGui::Checkbox("UDP (unreliable, lowest latency)", &use_udp_);
                 
-                ImGui::InputText("IP Address", ip_buffer, sizeof(ip_buffer));
-                ImGui::InputInt("Port", &port);
+                ImGui::BeginDisabled(use_udp_);
+                if (ImGui::BeginCombo("TCP Profile", profile_options[profile_index_].name)) {
+                    for (int n = 0; n < IM_ARRAYSIZE(profile_options); n++) {
+                        const bool is_selected = (profile_index_ == n);
+                        if (ImGui::Selectable(profile_options[n].name, is_selected)) {
+                            profile_index_ = n;
+                        }
+                        if (is_selected) ImGui::SetItemDefaultFocus();
+                    }
+                    ImGui::EndCombo();
+                }
+                ImGui::EndDisabled();
                 
                 if (ImGui::Button("Connect Network", ImVec2(-1, 0))) {
-                    log_info("Connecting to network: {}:{}", ip_buffer, port);
-                    comm.connectNetwork(ip_buffer, static_cast<uint16_t>(port));
+                    log_info("Connecting to network: {}:{} ({})", ip_buffer_, network_port_, use_udp_ ? "UDP" : "TCP");
+                    if (use_udp_) {
+                        comm.connectUdp(ip_buffer_, static_cast<uint16_t>(network_port_));
+                    } else {
+                        comm.setSocketProfile(profile_options[profile_index_]);
+                        comm.connectNetwork(ip_buffer_, static_cast<uint16_t>(network_port_));
+                    }
+                }
+            
+            } else if (connection_type_ == TransType::Replay) {
+                static const std::pair<const char*, double> speed_options[] = {
+                    {"1x", 1.0},
+                    {"2x", 2.0},
+                    {"5x", 5.0},
+                    {"10x", 10.0},
+                    {"Max", ReplayTransport::MAX_SPEED}
+                };
+                
+                ImGui::InputText("Recording", replay_path_buffer_, sizeof(replay_path_buffer_));
+                if (ImGui::BeginCombo("Speed", speed_options[replay_speed_index_].first)) {
+                    for (int n = 0; n < IM_ARRAYSIZE(speed_options); n++) {
+                        const bool is_selected = (replay_speed_index_ == n);
+                        if (ImGui::Selectable(speed_options[n].first, is_selected)) {
+                            replay_speed_index_ = n;
+                        }
+                        if (is_selected) ImGui::SetItemDefaultFocus();
+                    }
+                    ImGui::EndCombo();
+                }
+                
+                if (ImGui::Button("Start Replay", ImVec2(-1, 0))) {
+                    log_info("Replaying: {} at {}", replay_path_buffer_, speed_options[replay_speed_index_].first);
+                    comm.connectReplay(replay_path_buffer_, speed_options[replay_speed_index_].second);
                 }
             }
         }
         ImGui::EndDisabled();
         
-        if (is_connected) {
+        if (link_stats.link_losses > 0) {
+            ImGui::Text("Link drops: %llu, last recovery %.0f ms (max %.0f ms)",
+                        static_cast<unsigned long long>(link_stats.link_losses),
+                        link_stats.last_recovery_s * 1000.0,
+                        link_stats.max_recovery_s * 1000.0);
+        }
+        
+        if (auto replay = comm.getReplayStats()) {
+            ImGui::Text("Replay: %llu/%llu packets, %.0f packets/s%s",
+                        static_cast<unsigned long long>(replay->packets_replayed),
+                        static_cast<unsigned long long>(replay->packets_total),
+                        replay->packets_per_second,
+                        replay->finished ? " (done)" : "");
+        }
+        
+        if (is_connected || is_connecting) {
             ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0.8f, 0.0f, 0.0f, 0.6f));
             ImGui::PushStyleColor(ImGuiCol_ButtonHovered, ImVec4(1.0f, 0.0f, 0.0f, 0.8f));
             ImGui::PushStyleColor(ImGuiCol_ButtonActive, ImVec4(0.6f, 0.0f, 0.0f, 1.0f));
             
-            if (ImGui::Button("Disconnect", ImVec2(-1, 0))) {
-                log_info("Disconnecting");
+            if (ImGui::Button(is_connecting ? "Cancel" : "Disconnect", ImVec2(-1, 0))) {
+                log_info("{}", is_connecting ? "Cancelling connection attempt" : "Disconnecting");
                 comm.disconnect();
             }
             
@@ -224,7 +338,7 @@ void GimbalControlView::render() {
         
         ImGui::BeginDisabled(!comm.isConnected());
         {
-            auto mode = gimbal.getMode();
+            auto mode = gimbal.mode;
             
             ImGui::Text("Mode:");
             ImGui::SameLine();
@@ -258,16 +372,17 @@ void GimbalControlView::render() {
             
             if (ImGui::Button("ARM", ImVec2(-1, 40))) {
                 log_info("Sending ARM command");
-                // TODO: Create protobuf ARM message
-                // std::vector<uint8_t> cmd_data = createArmCommand();
-                // comm.sendMessage(cmd_data, [](bool success) {
-                //     log_info("ARM command {}", success ? "ACKed" : "timeout");
-                // });
+                comm.sendArm();
             }
             
             if (ImGui::Button("DISARM (FREE)", ImVec2(-1, 40))) {
                 log_info("Sending DISARM command");
-                // TODO: Create protobuf DISARM message
+                comm.sendDisarm();
+            }
+            
+            if (last_command_) {
+                ImGui::TextColored(last_command_acked_ ? ImVec4(0.0f, 1.0f, 0.0f, 1.0f) : ImVec4(1.0f, 0.3f, 0.0f, 1.0f),
+                                   "%s %s", last_command_, last_command_acked_ ? "acked" : "failed");
             }
         }
         ImGui::EndDisabled();
@@ -283,12 +398,10 @@ void GimbalControlView::render() {
     {
         ImGui::SeparatorText("Object Tracking");
         
-        static bool is_tracking = false;
-        
         ImGui::Text("Tracking:");
         ImGui::SameLine();
         
-        if (is_tracking) {
+        if (is_tracking_) {
             ImGui::PushStyleColor(ImGuiCol_Text, ImVec4(0.0f, 1.0f, 0.0f, 1.0f));
             ImGui::Text("TRACKING");
             ImGui::PopStyleColor();
@@ -302,17 +415,17 @@ void GimbalControlView::render() {
         ImGui::Separator();
         ImGui::Spacing();
         
-        bool enable_tracking = comm.isConnected() && (connection_type == TransType::Network);
+        bool enable_tracking = comm.isConnected() && (connection_type_ == TransType::Network);
         ImGui::BeginDisabled(!enable_tracking);
         {
             if (ImGui::Button("Enable Tracking", ImVec2(-1, 40))) {
-                is_tracking = true;
+                is_tracking_ = true;
                 log_info("Object tracking enabled");
                 // TODO: Send tracking command
             }
             
             if (ImGui::Button("Disable Tracking", ImVec2(-1, 40))) {
-                is_tracking = false;
+                is_tracking_ = false;
                 log_info("Object tracking disabled");
                 // TODO: Send tracking command
             }
@@ -333,34 +446,31 @@ void GimbalControlView::render() {
     {
         ImGui::SeparatorText("Streaming");
         
-        static bool is_streaming = false;
-        static bool was_connected = false;
-        
         bool currently_connected = comm.isConnected();
         
         // Auto-enable streaming on serial connection
-        if (currently_connected && !was_connected) {
-            if (connection_type == TransType::Serial) {
-                is_streaming = true;
+        if (currently_connected && !was_connected_) {
+            if (connection_type_ == TransType::Serial) {
+                is_streaming_ = true;
                 log_info("Serial connected - streaming enabled by default");
             } else {
-                is_streaming = false;
+                is_streaming_ = false;
             }
         }
         
         // Auto-disable on disconnect
-        if (!currently_connected && was_connected) {
-            is_streaming = false;
+        if (!currently_connected && was_connected_) {
+            is_streaming_ = false;
         }
         
-        was_connected = currently_connected;
+        was_connected_ = currently_connected;
         
         ImGui::Text("Status:");
         ImGui::SameLine();
         
         if (!comm.isConnected()) {
             ImGui::TextColored(ImVec4(0.5f, 0.5f, 0.5f, 1.0f), "N/A");
-        } else if (is_streaming) {
+        } else if (is_streaming_) {
             ImGui::TextColored(ImVec4(0.0f, 1.0f, 0.0f, 1.0f), "Streaming");
         } else {
             ImGui::TextColored(ImVec4(0.5f, 0.5f, 0.5f, 1.0f), "Not Streaming");
@@ -376,19 +486,18 @@ void GimbalControlView::render() {
                 {"5 Hz", 5}, {"10 Hz", 10}, {"20 Hz", 20},
                 {"30 Hz", 30}, {"40 Hz", 40}, {"50 Hz", 50}
             };
-            static int stream_rate_index = 2;
             
             ImGui::Text("Stream Rate:");
             
-            if (ImGui::BeginCombo("##StreamRate", stream_rate_options[stream_rate_index].first)) {
+            if (ImGui::BeginCombo("##StreamRate", stream_rate_options[stream_rate_index_].first)) {
                 for (int n = 0; n < IM_ARRAYSIZE(stream_rate_options); n++) {
-                    const bool is_selected = (stream_rate_index == n);
+                    const bool is_selected = (stream_rate_index_ == n);
                     if (ImGui::Selectable(stream_rate_options[n].first, is_selected)) {
-                        stream_rate_index = n;
-                        if (is_streaming) {
-                            int rate = stream_rate_options[stream_rate_index].second;
+                        stream_rate_index_ = n;
+                        if (is_streaming_) {
+                            int rate = stream_rate_options[stream_rate_index_].second;
                             log_info("Stream rate changed to {} Hz", rate);
-                            // TODO: Send rate change command
+                            comm.setStreamRate(static_cast<uint32_t>(rate));
                         }
                     }
                     if (is_selected) ImGui::SetItemDefaultFocus();
@@ -401,20 +510,20 @@ void GimbalControlView::render() {
             ImGui::Spacing();
             
             if (ImGui::Button("Start Streaming", ImVec2(-1, 0))) {
-                if (!is_streaming) {
-                    is_streaming = true;
-                    int rate = stream_rate_options[stream_rate_index].second;
+                if (!is_streaming_) {
+                    is_streaming_ = true;
+                    int rate = stream_rate_options[stream_rate_index_].second;
                     log_info("Started streaming at {} Hz", rate);
-                    // TODO: Send start streaming command
+                    comm.setStreaming(true, static_cast<uint32_t>(rate));
                 }
             }
             
-            ImGui::BeginDisabled(!is_streaming);
+            ImGui::BeginDisabled(!is_streaming_);
             {
                 if (ImGui::Button("Stop Streaming", ImVec2(-1, 0))) {
-                    is_streaming = false;
+                    is_streaming_ = false;
                     log_info("Stopped streaming");
-                    // TODO: Send stop streaming command
+                    comm.setStreaming(false);
                 }
             }
             ImGui::EndDisabled();
@@ -433,40 +542,13 @@ void GimbalControlView::render() {
     {
         ImGui::SeparatorText("Gimbal Position");
         
-        static const int MAX_POINTS = 500;
-        static std::vector<double> time_data;
-        static std::vector<double> pan_pos_data;
-        static std::vector<double> pan_setpoint_data;
-        static double last_update_time = 0.0;
-        
         // Get real data from GimbalState
-        auto position = gimbal.getPosition();
-        auto setpoint = gimbal.getSetpoint();
-        
-        // Update plot data when connected (20Hz)
-        double current_time = ImGui::GetTime();
-        if (comm.isConnected() && !gimbal.isStale() && (current_time - last_update_time) >= 0.05) {
-            time_data.push_back(current_time);
-            pan_pos_data.push_back(position.pan_deg);
-            pan_setpoint_data.push_back(setpoint.pan_deg);
-            
-            if (time_data.size() > MAX_POINTS) {
-                time_data.erase(time_data.begin());
-                pan_pos_data.erase(pan_pos_data.begin());
-                pan_setpoint_data.erase(pan_setpoint_data.begin());
-            }
-            
-            last_update_time = current_time;
-        }
+        const auto& position = gimbal.position;
+        const auto& setpoint = gimbal.setpoint;
         
-        // Clear data when disconnected
-        static bool was_connected_last_frame = false;
-        if (!comm.isConnected() && was_connected_last_frame) {
-            time_data.clear();
-            pan_pos_data.clear();
-            pan_setpoint_data.clear();
-        }
-        was_connected_last_frame = comm.isConnected();
+        // Fold samples recorded by the I/O thread since last frame into the
+        // decimation pyramid (a few per frame at streaming rates)
+        plot_decimator_.update(gimbal_state_.getHistory());
         
         // Display real values
         ImGui::BeginDisabled(!comm.isConnected());
@@ -485,20 +567,77 @@ void GimbalControlView::render() {
         }
         ImGui::EndDisabled();
         
+        ImGui::Spacing();
+        
+        // Raw packet recording (keeps running across reconnects)
+        if (comm.isRecording()) {
+            auto stats = comm.getRecordingStats();
+            
+            ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0.8f, 0.0f, 0.0f, 0.6f));
+            ImGui::PushStyleColor(ImGuiCol_ButtonHovered, ImVec4(1.0f, 0.0f, 0.0f, 0.8f));
+            ImGui::PushStyleColor(ImGuiCol_ButtonActive, ImVec4(0.6f, 0.0f, 0.0f, 1.0f));
+            if (ImGui::Button("Stop Recording")) {
+                comm.stopRecording();
+            }
+            ImGui::PopStyleColor(3);
+            
+            ImGui::SameLine();
+            ImGui::TextColored(ImVec4(1.0f, 0.2f, 0.2f, 1.0f), "REC");
+            ImGui::SameLine();
+            ImGui::Text("%.0fs  %llu packets  %.1f KiB", stats.duration_s,
+                        static_cast<unsigned long long>(stats.records), stats.bytes / 1024.0);
+            if (stats.dropped > 0) {
+                ImGui::SameLine();
+                ImGui::TextColored(ImVec4(1.0f, 0.3f, 0.0f, 1.0f), "(%llu dropped)",
+                                   static_cast<unsigned long long>(stats.dropped));
+            }
+            if (ImGui::IsItemHovered()) {
+                ImGui::SetTooltip("%s", comm.getRecordingPath().c_str());
+            }
+        } else {
+            if (ImGui::Button("Start Recording")) {
+                comm.startRecording(makeRecordingPath());
+            }
+            if (ImGui::IsItemHovered()) {
+                ImGui::SetTooltip("Record every received and sent packet to recordings/");
+            }
+        }
+        
         ImGui::Spacing();
         ImGui::Separator();
         ImGui::Spacing();
         
         // Plot
-        int data_size = static_cast<int>(time_data.size());
-        if (data_size > 1) {
-            if (ImPlot::BeginPlot("Pan Position", ImVec2(-1, right_combined_height - 120))) {
+        double first_time = 0.0;
+        double last_time = 0.0;
+        if (plot_decimator_.getTimeRange(first_time, last_time) && last_time > first_time) {
+            ImGui::Checkbox("Follow", &plot_follow_);
+            if (ImGui::IsItemHovered()) {
+                ImGui::SetTooltip("Scroll with incoming data. Untick to pan and zoom through the history.");
+            }
+            ImGui::SameLine();
+            ImGui::SetNextItemWidth(120);
+            ImGui::InputFloat("Window (s)", &plot_window_s_, 10.0f, 60.0f, "%.0f");
+            plot_window_s_ = std::max(plot_window_s_, 1.0f);
+            
+            if (ImPlot::BeginPlot("Pan Position", ImVec2(-1, right_combined_height - 180))) {
                 ImPlot::SetupAxes("Time (s)", "Position (deg)");
-                ImPlot::SetupAxisLimits(ImAxis_X1, time_data[0], time_data[data_size - 1], ImGuiCond_Always);
+                if (plot_follow_) {
+                    ImPlot::SetupAxisLimits(ImAxis_X1, std::max(first_time, last_time - plot_window_s_),
+                                            last_time, ImGuiCond_Always);
+                }
                 ImPlot::SetupAxisLimits(ImAxis_Y1, -180, 180, ImGuiCond_Once);
+                ImPlot::SetupFinish();
+                
+                // About one min/max pair per horizontal pixel, whatever the zoom
+                ImPlotRect limits = ImPlot::GetPlotLimits();
+                PlotDecimator::Series series = plot_decimator_.query(
+                    limits.X.Min, limits.X.Max, ImPlot::GetPlotSize().x);
                 
-                ImPlot::PlotLine("Position", time_data.data(), pan_pos_data.data(), data_size);
-                ImPlot::PlotLine("Setpoint", time_data.data(), pan_setpoint_data.data(), data_size);
+                if (series.count > 1) {
+                    ImPlot::PlotLine("Position", series.time, series.pan_position, series.count);
+                    ImPlot::PlotLine("Setpoint", series.time, series.pan_setpoint, series.count);
+                }
                 
                 ImPlot::EndPlot();
             }
@@ -520,37 +659,63 @@ void GimbalControlView::render() {
         
         ImGui::BeginDisabled(!comm.isConnected());
         {
-            static char target_pan_buffer[32] = "0.0";
-            
-            ImGui::InputText("Target Pan (°)", target_pan_buffer, sizeof(target_pan_buffer));
+            ImGui::InputText("Target Pan (°)", target_pan_buffer_, sizeof(target_pan_buffer_));
             
             ImGui::Spacing();
             
             if (ImGui::Button("Demand Position", ImVec2(-1, 0))) {
-                float pan = std::atof(target_pan_buffer);
+                float pan = std::atof(target_pan_buffer_);
                 log_info("Demanding position: pan={}", pan);
-                // TODO: Create protobuf position command
-                // std::vector<uint8_t> cmd = createPositionCommand(pan);
-                // comm.sendMessage(cmd, [](bool success) {
-                //     log_info("Position command {}", success ? "ACKed" : "timeout");
-                // });
+                comm.sendPositionDemand(pan);
             }
             
             ImGui::Spacing();
             
             if (ImGui::Button("Go to 0°", ImVec2(-1, 0))) {
-                std::strcpy(target_pan_buffer, "0.0");
+                std::strcpy(target_pan_buffer_, "0.0");
             }
             
             if (ImGui::Button("Go to 90°", ImVec2(-1, 0))) {
-                std::strcpy(target_pan_buffer, "90.0");
+                std::strcpy(target_pan_buffer_, "90.0");
             }
             
             if (ImGui::Button("Go to -90°", ImVec2(-1, 0))) {
-                std::strcpy(target_pan_buffer, "-90.0");
+                std::strcpy(target_pan_buffer_, "-90.0");
             }
         }
         ImGui::EndDisabled();
+        
+        // Send-to-ack time of every acked command since the last reset
+        auto latency = comm.getCommandLatency();
+        if (!latency.empty()) {
+            ImGui::Spacing();
+            ImGui::SeparatorText("Command Latency (ms)");
+            
+            for (const auto& entry : latency) {
+                ImGui::Text("%s  n=%llu", entry.type, static_cast<unsigned long long>(entry.rtt.count));
+                if (entry.failures > 0) {
+                    ImGui::SameLine();
+                    ImGui::TextColored(ImVec4(1.0f, 0.3f, 0.0f, 1.0f), "%llu failed",
+                                       static_cast<unsigned long long>(entry.failures));
+                }
+                if (entry.rtt.count > 0) {
+                    ImGui::Text("  p50 %.2f  p99 %.2f  p99.9 %.2f  max %.2f",
+                                entry.rtt.p50_us / 1000.0, entry.rtt.p99_us / 1000.0,
+                                entry.rtt.p999_us / 1000.0, entry.rtt.max_us / 1000.0);
+                }
+            }
+            
+            if (ImGui::Button("Export")) {
+                exportLatencyReport(comm.getCommandLatencyJson());
+            }
+            if (ImGui::IsItemHovered()) {
+                ImGui::SetTooltip("Write summaries and histogram buckets to recordings/");
+            }
+            ImGui::SameLine();
+            if (ImGui::Button("Reset")) {
+                comm.resetCommandLatency();
+            }
+        }
     }
     ImGui::EndChild();
     
@@ -6,23 +6,53 @@
 #include "rendering/views.hpp"
 #include "core/gimbal_state.hpp"
 #include "core/communication_backend.hpp"
+#include "rendering/plot_decimator.hpp"
+#include "util/events.hpp"
 
 namespace Rendering {
 
 class GimbalControlView : public View {
 public:
     GimbalControlView(GimbalState& gimbal_state, CommunicationBackend& comm_backend);
+    ~GimbalControlView() override;
     void render() override;
-
+    
 private:
     void refreshSerialPorts();
-
+    static std::string makeRecordingPath();
+    static bool exportLatencyReport(const std::string& json);
+    
     GimbalState& gimbal_state_;
     CommunicationBackend& comm_backend_;
     
     // Serial port dropdown state
     std::vector<std::string> available_serial_ports_;
     size_t selected_port_index_ = 0;
+    
+    // Position plot
+    PlotDecimator plot_decimator_;
+    bool plot_follow_ = true;
+    float plot_window_s_ = 30.0f;
+    
+    // Per-device form and link state (one view per device)
+    CommunicationBackend::TransportType connection_type_ = CommunicationBackend::TransportType::Serial;
+    int baud_rate_index_ = 4;
+    char ip_buffer_[128] = "192.168.1.100";
+    int network_port_ = 3883;
+    bool use_udp_ = false;
+    int profile_index_ = 0;
+    char replay_path_buffer_[256] = "recordings/";
+    int replay_speed_index_ = 0;
+    bool is_tracking_ = false;
+    bool is_streaming_ = false;
+    bool was_connected_ = false;
+    int stream_rate_index_ = 2;
+    char target_pan_buffer_[32] = "0.0";
+    
+    // Last typed command result for this device (Events::CommandEvent)
+    Events::EventBus::SubscriptionId command_subscription_ = 0;
+    const char* last_command_ = nullptr;
+    bool last_command_acked_ = false;
 };
 
 } // namespace Rendering
@@ -1,65 +1,83 @@
 #include "util/events.hpp"
 #include "util/logging.hpp"
+#include <algorithm>
 
 namespace Events {
 
-void EventQueue::subscribe(const std::string& event_type, EventCallback callback) {
-    subscribers_[event_type].push_back(std::move(callback));
-    log_debug("Subscribed to event: {}", event_type);
+EventBus::EventBus()
+    : dropped_(0)
+    , subscribers_(std::make_shared<SubscriberTable>())
+    , next_subscription_(1) {
 }
 
-void EventQueue::unsubscribe(const std::string& event_type) {
-    auto it = subscribers_.find(event_type);
-    if (it != subscribers_.end()) {
-        subscribers_.erase(it);
-        log_debug("Unsubscribed from event: {}", event_type);
+EventBus::SubscriptionId EventBus::addSubscriber(size_t index, Callback callback) {
+    std::lock_guard<std::mutex> lock(subscribers_mutex_);
+    auto table = std::make_shared<SubscriberTable>(*subscribers_);
+    SubscriptionId id = next_subscription_++;
+    (*table)[index].push_back(Subscriber{id, std::move(callback)});
+    subscribers_ = std::move(table);
+    
+    log_debug("Subscription {} to event {}", id, index);
+    return id;
+}
+
+void EventBus::unsubscribe(SubscriptionId id) {
+    std::lock_guard<std::mutex> lock(subscribers_mutex_);
+    auto table = std::make_shared<SubscriberTable>(*subscribers_);
+    for (auto& subscribers : *table) {
+        subscribers.erase(std::remove_if(subscribers.begin(), subscribers.end(),
+            [id](const Subscriber& subscriber) { return subscriber.id == id; }),
+            subscribers.end());
     }
+    subscribers_ = std::move(table);
+    
+    log_debug("Unsubscribed {}", id);
 }
 
-void EventQueue::clearAll() {
-    std::lock_guard<std::mutex> lock(queue_mutex_);
-    subscribers_.clear();
-    std::queue<Event_ptr> empty;
-    event_queue_.swap(empty);
+void EventBus::clearAll() {
+    {
+        std::lock_guard<std::mutex> lock(subscribers_mutex_);
+        subscribers_ = std::make_shared<SubscriberTable>();
+    }
+    
+    while (queue_.consume([](Event&) {})) {
+    }
     log_debug("Cleared all event subscriptions and queued events");
 }
 
-void EventQueue::post(Event_ptr event) {
-    if (!event) {
-        log_warn("Attempted to post null event");
-        return;
+void EventBus::setWakeHandler(std::function<void()> handler) {
+    wake_handler_ = std::move(handler);
+}
+
+bool EventBus::postEvent(Event&& event) {
+    if (queue_.push(std::move(event))) {
+        notify();
+        return true;
     }
     
-    std::lock_guard<std::mutex> lock(queue_mutex_);
-    log_debug("Posted event to queue:  {}", event->getType());
-    event_queue_.push(std::move(event));
+    // Nobody polling (headless) or the GUI is stalled
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+    log_warn_limited("Event queue full, dropping event {}", event.index());
+    return false;
 }
 
-void EventQueue::pollEvents() {
-    std::queue<Event_ptr> events_to_process;
-    
-    // Move all events from queue to local queue
+void EventBus::pollEvents() {
+    std::shared_ptr<const SubscriberTable> table;
     {
-        std::lock_guard<std::mutex> lock(queue_mutex_);
-        events_to_process.swap(event_queue_);
+        std::lock_guard<std::mutex> lock(subscribers_mutex_);
+        table = subscribers_;
     }
     
-    // Process all events
-    while (!events_to_process.empty()) {
-        auto& event = events_to_process.front();
-        const auto& event_type = event->getType();
-        
-        auto it = subscribers_.find(event_type);
-        if (it != subscribers_.end()) {
-            log_debug("Processing event: {}", event_type);
-            for (const auto& callback : it->second) {
-                callback(*event);
+    // At most one ring's worth, so handlers that post cannot keep us here
+    for (size_t i = 0; i < QUEUE_CAPACITY; ++i) {
+        bool handled = queue_.consume([&table](Event& event) {
+            for (const auto& subscriber : (*table)[event.index()]) {
+                subscriber.callback(event);
             }
-        } else {
-            log_debug("No subscribers for event: {}", event_type);
+        });
+        if (!handled) {
+            break;
         }
-        
-        events_to_process.pop();
     }
 }
 
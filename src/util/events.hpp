@@ -1,78 +1,171 @@
 #ifndef EVENTS_HPP
 #define EVENTS_HPP
 
-#include <string>
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <functional>
-#include <unordered_map>
 #include <vector>
 #include <memory>
-#include <queue>
 #include <mutex>
+#include <type_traits>
+#include <variant>
+#include "util/mpsc_queue.hpp"
 
-// Forward declaration
+// Forward declarations
 namespace Rendering {
     class View;
 }
+class CommunicationBackend;
 
 namespace Events {
 
-class Event {
-public:  
-    explicit Event(std::string type) : type_(std::move(type)) {}
-    virtual ~Event() = default;
-    
-    const std::string& getType() const { return type_; }
-    
-private: 
-    std::string type_;
+/**
+ * Compile-time event IDs, in the order of the Event variant
+ */
+enum class EventId : uint8_t {
+    None = 0,       // Empty queue slot
+    SetView,
+    Link,
+    Command,
+    Count
 };
 
-class SetViewEvent :  public Event {
-public:
-    explicit SetViewEvent(std::shared_ptr<Rendering::View> view) 
-        : Event("views/set_view")
-        , view_(std::move(view)) {}
-    
-    std::shared_ptr<Rendering::View> getView() const { return view_; }
+struct SetViewEvent {
+    static constexpr EventId ID = EventId::SetView;
+    std::shared_ptr<Rendering::View> view;
+};
 
-private:
-    std::shared_ptr<Rendering::View> view_;
+// A device's link dropped or came back (posted by the backend's supervisor)
+struct LinkEvent {
+    static constexpr EventId ID = EventId::Link;
+    enum class Kind : uint8_t {
+        Lost,
+        Recovered
+    };
+    const CommunicationBackend* source = nullptr;   // For matching only: may be gone when handled
+    Kind kind = Kind::Lost;
 };
 
-using EventCallback = std::function<void(const Event&)>;
-using Event_ptr = std::unique_ptr<Event>;
+// A typed command was acked or failed (posted from the I/O thread)
+struct CommandEvent {
+    static constexpr EventId ID = EventId::Command;
+    const CommunicationBackend* source = nullptr;   // For matching only: may be gone when handled
+    const char* name = "";                          // Static string
+    bool success = false;
+};
+
+using Event = std::variant<std::monostate, SetViewEvent, LinkEvent, CommandEvent>;
+static_assert(std::variant_size_v<Event> == static_cast<size_t>(EventId::Count),
+              "Every EventId needs its alternative in Events::Event");
 
-class EventQueue {
+/**
+ * Typed event bus: any thread posts, the GUI thread handles once per frame
+ * 
+ * Events are small value types stored in place in a preallocated lock-free
+ * ring (MpscQueue), so post() is a CAS and a move: no allocation, no lock,
+ * cheap enough for the I/O thread. When the ring is full the event is
+ * dropped and counted rather than blocking the poster.
+ * 
+ * Handlers are looked up by the event's compile-time ID and receive the
+ * concrete type. subscribe()/unsubscribe() may be called from any thread,
+ * including from a handler; they take effect from the next pollEvents(),
+ * so unsubscribe outside a poll before destroying what a handler uses.
+ * 
+ * A consumer that sleeps between polls sets a wake handler; it runs on the
+ * poster's thread after each post and on notify().
+ */
+class EventBus {
 public:
-    static EventQueue& getInstance() {
-        static EventQueue instance;
+    static constexpr size_t QUEUE_CAPACITY = 1024;
+    using SubscriptionId = uint64_t;
+    
+    static EventBus& getInstance() {
+        static EventBus instance;
         return instance;
     }
     
-    // Subscribe to an event type
-    void subscribe(const std::string& event_type, EventCallback callback);
+    /**
+     * Call callback on the polling thread for every posted T
+     * @return Handle for unsubscribe()
+     */
+    template<typename T>
+    SubscriptionId subscribe(std::function<void(const T&)> callback) {
+        constexpr size_t index = static_cast<size_t>(T::ID);
+        static_assert(std::is_same_v<std::variant_alternative_t<index, Event>, T>,
+                      "Event ID does not match its position in Events::Event");
+        return addSubscriber(index, [callback = std::move(callback)](const Event& event) {
+            callback(*std::get_if<index>(&event));
+        });
+    }
+    
+    void unsubscribe(SubscriptionId id);
     
-    // Unsubscribe all callbacks for an event type
-    void unsubscribe(const std::string& event_type);
+    /**
+     * Queue an event (any thread)
+     * @return false if the queue was full and the event was dropped
+     */
+    template<typename T>
+    bool post(T event) {
+        return postEvent(Event(std::in_place_type<T>, std::move(event)));
+    }
     
-    // Clear all subscribers and queued events
+    /**
+     * Handle everything queued (call once per frame, always from the same thread)
+     */
+    void pollEvents();
+    
+    /**
+     * Drop all subscribers and queued events (polling thread, at shutdown)
+     */
     void clearAll();
     
-    // Post an event to the queue (deferred execution)
-    void post(Event_ptr event);
+    /**
+     * Called on the posting thread after every post() and notify(), e.g. to
+     * wake a consumer that sleeps between polls. Set or clear it only while
+     * no other thread posts (at startup and shutdown).
+     */
+    void setWakeHandler(std::function<void()> handler);
     
-    // Process all queued events (call once per frame)
-    void pollEvents();
+    /**
+     * Wake the consumer without queueing anything: state it reads directly
+     * (e.g. GimbalState) has changed. Any thread.
+     */
+    void notify() {
+        if (wake_handler_) {
+            wake_handler_();
+        }
+    }
+    
+    uint64_t getDroppedCount() const { return dropped_.load(std::memory_order_relaxed); }
     
 private:
-    EventQueue() = default;
-    ~EventQueue() = default;
-    EventQueue(const EventQueue&) = delete;
-    EventQueue& operator=(const EventQueue&) = delete;
-    
-    std::unordered_map<std::string, std::vector<EventCallback>> subscribers_;
-    std::queue<Event_ptr> event_queue_;
-    std::mutex queue_mutex_;
+    using Callback = std::function<void(const Event&)>;
+    
+    struct Subscriber {
+        SubscriptionId id;
+        Callback callback;
+    };
+    
+    using SubscriberTable = std::array<std::vector<Subscriber>, static_cast<size_t>(EventId::Count)>;
+    
+    EventBus();
+    ~EventBus() = default;
+    EventBus(const EventBus&) = delete;
+    EventBus& operator=(const EventBus&) = delete;
+    
+    SubscriptionId addSubscriber(size_t index, Callback callback);
+    bool postEvent(Event&& event);
+    
+    MpscQueue<Event, QUEUE_CAPACITY> queue_;
+    std::atomic<uint64_t> dropped_;
+    std::function<void()> wake_handler_;
+    
+    // Copy-on-write: changes swap in a new table, pollEvents() dispatches
+    // from the one current when it started
+    std::shared_ptr<const SubscriberTable> subscribers_;
+    std::mutex subscribers_mutex_;
+    SubscriptionId next_subscription_;
 };
 
 } // namespace Events
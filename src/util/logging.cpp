@@ -1,6 +1,8 @@
 #include "util/logging.hpp"
+#include "spdlog/async.h"
 #include "spdlog/sinks/rotating_file_sink.h"
 #include "spdlog/sinks/stdout_color_sinks.h"
+#include <chrono>
 #include <memory>
 #include <filesystem>
 
@@ -9,6 +11,8 @@ constexpr const char* LOG_FILE = "logs/app.log";
 constexpr const char* LOGGER_NAME = "app_logger";
 constexpr size_t LOG_FILE_SIZE_BYTES = 1024 * 1024 * 5;  // 5 MB
 constexpr size_t LOG_FILE_COUNT = 3;  // Keep 3 rotating log files
+constexpr size_t LOG_QUEUE_SIZE = 8192;  // Messages, preallocated by the thread pool
+constexpr std::chrono::seconds LOG_FLUSH_INTERVAL{1};
 
 void initialize_logging() {
     try {
@@ -32,8 +36,12 @@ void initialize_logging() {
         // Combine sinks
         spdlog::sinks_init_list sink_list = {console_sink, file_sink};
 
-        // Create logger with both sinks
-        auto logger = std::make_shared<spdlog::logger>(LOGGER_NAME, sink_list);
+        // One background thread writes both sinks from a fixed-size queue.
+        // Callers never wait for it: when the queue is full the oldest
+        // message is overwritten instead.
+        spdlog::init_thread_pool(LOG_QUEUE_SIZE, 1);
+        auto logger = std::make_shared<spdlog::async_logger>(
+            LOGGER_NAME, sink_list, spdlog::thread_pool(), spdlog::async_overflow_policy::overrun_oldest);
         
         // Set log level (trace = most verbose, critical = least verbose)
 #ifdef NDEBUG
@@ -45,8 +53,10 @@ void initialize_logging() {
         // Set pattern:  [timestamp] [level] message
         logger->set_pattern("[%Y-%m-%d %H:%M:%S.%e] [%^%l%$] %v");
         
-        // Always flush error level and above immediately
+        // Flush error level and above as soon as the writer reaches them,
+        // everything else at least every LOG_FLUSH_INTERVAL
         logger->flush_on(spdlog::level::err);
+        spdlog::flush_every(LOG_FLUSH_INTERVAL);
         
         // Set as default logger
         spdlog::set_default_logger(logger);
@@ -59,12 +69,31 @@ void initialize_logging() {
     }
 }
 
+bool LogRateLimiter::allow(uint64_t& suppressed) {
+    int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    
+    // Whoever moves the window on resets the count
+    int64_t start = window_start_ns_.load(std::memory_order_relaxed);
+    if (now - start >= WINDOW_NS &&
+        window_start_ns_.compare_exchange_strong(start, now, std::memory_order_relaxed)) {
+        count_.store(0, std::memory_order_relaxed);
+    }
+    
+    if (count_.fetch_add(1, std::memory_order_relaxed) < BURST) {
+        suppressed = suppressed_.exchange(0, std::memory_order_relaxed);
+        return true;
+    }
+    suppressed_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
 void shutdown_logging() {
     // Flush all logs before shutdown
     if (spdlog::default_logger()) {
         spdlog::default_logger()->flush();
     }
     
-    // Drop all loggers and clean up
-    spdlog::drop_all();
+    // Drop all loggers, then drain the queue and join the writer thread
+    spdlog::shutdown();
 }
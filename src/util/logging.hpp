@@ -1,30 +1,41 @@
 #ifndef LOGGING_HPP
 #define LOGGING_HPP
 
+// Calls below this level are compiled out (arguments not even evaluated).
+// Must be set before spdlog is included; override with -DSPDLOG_ACTIVE_LEVEL=...
+#ifndef SPDLOG_ACTIVE_LEVEL
+#ifdef NDEBUG
+#define SPDLOG_ACTIVE_LEVEL SPDLOG_LEVEL_INFO
+#else
+#define SPDLOG_ACTIVE_LEVEL SPDLOG_LEVEL_TRACE
+#endif
+#endif
+
 #include "spdlog/spdlog.h"
+#include <atomic>
+#include <cstdint>
 
 /**
  * Initialize logging system with console and file output.
  * Call this once at application startup.
+ * 
+ * The logger is asynchronous: a call formats the message and queues it for
+ * a background thread that writes the sinks, so the I/O thread never waits
+ * on the console or the disk. When the queue is full the oldest queued
+ * message is dropped rather than blocking the caller.
  */
 void initialize_logging();
 
 /**
  * Shutdown logging system.
- * Call this before application exit.
+ * Call this before application exit. Writes out everything still queued.
  */
 void shutdown_logging();
 
 // Convenient logging macros
-template<typename... Args>
-inline void log_trace(spdlog::format_string_t<Args...> fmt, Args &&... args) {
-    spdlog::trace(fmt, std::forward<Args>(args)...);
-}
-
-template<typename... Args>
-inline void log_debug(spdlog::format_string_t<Args...> fmt, Args &&... args) {
-    spdlog::debug(fmt, std::forward<Args>(args)...);
-}
+// Trace and debug are macros so release builds drop them entirely
+#define log_trace(...) SPDLOG_TRACE(__VA_ARGS__)
+#define log_debug(...) SPDLOG_DEBUG(__VA_ARGS__)
 
 template<typename... Args>
 inline void log_info(spdlog::format_string_t<Args...> fmt, Args &&... args) {
@@ -46,4 +57,46 @@ inline void log_critical(spdlog::format_string_t<Args...> fmt, Args &&... args)
     spdlog::critical(fmt, std::forward<Args>(args)...);
 }
 
+/**
+ * Per-call-site limit for messages a noisy link can repeat at packet rate
+ * 
+ * Lets BURST messages through per WINDOW, then drops them until the next
+ * window; the first message let through afterwards reports how many were
+ * dropped. Lock-free and approximate: a few extra messages may get
+ * through when several threads hit a window boundary at once.
+ */
+class LogRateLimiter {
+public:
+    static constexpr uint32_t BURST = 10;
+    static constexpr int64_t WINDOW_NS = 1000000000;    // 1 s
+    
+    /**
+     * @param suppressed Set to the number of messages dropped since the
+     *        last one allowed (only when returning true)
+     */
+    bool allow(uint64_t& suppressed);
+    
+private:
+    std::atomic<int64_t> window_start_ns_{0};
+    std::atomic<uint32_t> count_{0};
+    std::atomic<uint64_t> suppressed_{0};
+};
+
+// Rate-limited variants, one LogRateLimiter per call site
+#define LOG_RATE_LIMITED(level, ...)                                                        \
+    do {                                                                                    \
+        static LogRateLimiter log_rate_limiter_;                                            \
+        uint64_t log_suppressed_ = 0;                                                       \
+        if (spdlog::should_log(level) && log_rate_limiter_.allow(log_suppressed_)) {        \
+            if (log_suppressed_ > 0) {                                                      \
+                spdlog::log(level, "({} similar messages suppressed)", log_suppressed_);    \
+            }                                                                               \
+            spdlog::log(level, __VA_ARGS__);                                                \
+        }                                                                                   \
+    } while (0)
+
+#define log_info_limited(...) LOG_RATE_LIMITED(spdlog::level::info, __VA_ARGS__)
+#define log_warn_limited(...) LOG_RATE_LIMITED(spdlog::level::warn, __VA_ARGS__)
+#define log_error_limited(...) LOG_RATE_LIMITED(spdlog::level::err, __VA_ARGS__)
+
 #endif // LOGGING_HPP
@@ -0,0 +1,94 @@
+#ifndef MPSC_QUEUE_HPP
+#define MPSC_QUEUE_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+/**
+ * Bounded lock-free queue for many producers and one consumer
+ * 
+ * A ring of Capacity preallocated slots, each with a sequence number
+ * (Vyukov's bounded queue). A producer claims a slot with one CAS on the
+ * enqueue position, moves its value in and publishes it by bumping the
+ * slot's sequence; nothing is allocated and nobody waits on a lock. A
+ * full queue rejects the push instead of blocking the producer.
+ * 
+ * T must be default-constructible: a consumed slot is reset to T{} so it
+ * does not keep resources (e.g. a shared_ptr) alive until it is reused.
+ */
+template<typename T, size_t Capacity>
+class MpscQueue {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+    
+public:
+    MpscQueue() {
+        for (size_t i = 0; i < Capacity; ++i) {
+            slots_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+    
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+    
+    /**
+     * Any thread. False if the queue is full (value is left untouched).
+     */
+    bool push(T&& value) {
+        size_t position = enqueue_position_.load(std::memory_order_relaxed);
+        Slot* slot;
+        for (;;) {
+            slot = &slots_[position & (Capacity - 1)];
+            size_t sequence = slot->sequence.load(std::memory_order_acquire);
+            auto lag = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+            if (lag == 0) {
+                if (enqueue_position_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (lag < 0) {
+                return false;   // The consumer has not freed this slot yet
+            } else {
+                position = enqueue_position_.load(std::memory_order_relaxed);
+            }
+        }
+        
+        slot->value = std::move(value);
+        slot->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+    
+    /**
+     * Consumer thread only. Calls fn(T&) on the oldest value, then frees
+     * its slot. False if empty.
+     */
+    template<typename Fn>
+    bool consume(Fn&& fn) {
+        Slot& slot = slots_[dequeue_position_ & (Capacity - 1)];
+        size_t sequence = slot.sequence.load(std::memory_order_acquire);
+        if (sequence != dequeue_position_ + 1) {
+            return false;   // Not published yet
+        }
+        
+        fn(slot.value);
+        slot.value = T{};
+        slot.sequence.store(dequeue_position_ + Capacity, std::memory_order_release);
+        ++dequeue_position_;
+        return true;
+    }
+    
+    static constexpr size_t capacity() { return Capacity; }
+    
+private:
+    struct alignas(64) Slot {
+        std::atomic<size_t> sequence;
+        T value{};
+    };
+    
+    std::array<Slot, Capacity> slots_;
+    alignas(64) std::atomic<size_t> enqueue_position_{0};
+    alignas(64) size_t dequeue_position_ = 0;
+};
+
+#endif // MPSC_QUEUE_HPP